@@ -1,10 +1,27 @@
 #include "Config.h"
 
 namespace data {
-    const int Config::VERSION = 1;
+    const int Config::VERSION = 2;
     const std::string Config::RECORDS_BLOCKCHAIN_FILE_PATH = R"(../data/records/chain.txt)";
+    const std::string Config::RECORDS_BLOCKCHAIN_FORMAT = "text";
     const std::string Config::OPTIONS_SUPPLIER_FILE_PATH = R"(../data/options/suppliers.txt)";
     const std::string Config::OPTIONS_TRANSPORTER_FILE_PATH = R"(../data/options/transporters.txt)";
     const std::string Config::OPTIONS_TRANSACTION_FILE_PATH = R"(../data/options/transactions.txt)";
     const std::string Config::PARTICIPANTS_FILE_PATH = R"(../data/records/participants.txt)";
+    const std::string Config::BITS = "ffff001f";
+    const unsigned int Config::RETARGET_INTERVAL = 8;
+    const unsigned long long Config::TARGET_MINING_TIME = 1000;
+    const unsigned int Config::MINING_THREADS = 0;
+    const unsigned int Config::MINING_DUTY_CYCLE = 100;
+    const int Config::MINING_NICENESS = 10;
+    const unsigned long long Config::MINING_CPU_AFFINITY = 0;
+    const std::string Config::MINING_CHECKPOINT_FILE_PATH = R"(../data/records/chain.mining.txt)";
+    const unsigned int Config::MINING_CHECKPOINT_INTERVAL = 2000;
+    const unsigned int Config::MINING_PROGRESS_INTERVAL = 500;
+    const std::string Config::MINING_POOL_NAME = "/itms_mining_pool";
+    const unsigned long long Config::MINING_POOL_RANGE_SIZE = 1 << 20;
+    const unsigned int Config::VERIFY_THREADS = 0;
+    const std::string Config::RECORD_POOL_FILE_PATH = R"(../data/records/chain.pool.txt)";
+    const unsigned int Config::RECORD_POOL_MAX_RECORDS = 64;
+    const unsigned int Config::RECORD_POOL_MAX_AGE = 300;
 }
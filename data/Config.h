@@ -8,10 +8,27 @@ namespace data {
     public:
         static const int VERSION; /** The version of the blockchain */
         static const std::string RECORDS_BLOCKCHAIN_FILE_PATH; /** The path to the blockchain file */
+        static const std::string RECORDS_BLOCKCHAIN_FORMAT; /** The record format of the blockchain file, "text" or "binary", an existing file is converted at startup */
         static const std::string OPTIONS_SUPPLIER_FILE_PATH; /** The path to the supplier options file */
         static const std::string OPTIONS_TRANSPORTER_FILE_PATH; /** The path to the transporter options file */
         static const std::string OPTIONS_TRANSACTION_FILE_PATH; /** The path to the transaction options file */
         static const std::string PARTICIPANTS_FILE_PATH; /** The path to the participants file */
+        static const std::string BITS; /** The compact mining target every block hash must meet, lower is harder */
+        static const unsigned int RETARGET_INTERVAL; /** The number of blocks of a type between two adjustments of its mining target */
+        static const unsigned long long TARGET_MINING_TIME; /** The mean time to mine a block the retargeting aims for, in milliseconds */
+        static const unsigned int MINING_THREADS; /** The number of threads searching for a nonce, 0 uses every hardware thread */
+        static const unsigned int MINING_DUTY_CYCLE; /** The percentage of time the mining threads spend hashing, lower leaves more CPU to the prompts */
+        static const int MINING_NICENESS; /** The nice value added to the mining threads, so the foreground threads get the CPU first */
+        static const unsigned long long MINING_CPU_AFFINITY; /** The CPUs the mining threads are pinned to, bit n for CPU n, 0 leaves them unpinned */
+        static const std::string MINING_CHECKPOINT_FILE_PATH; /** The path to the sidecar file of the pending mining jobs */
+        static const unsigned int MINING_CHECKPOINT_INTERVAL; /** The milliseconds between two checkpoints of a mining job */
+        static const unsigned int MINING_PROGRESS_INTERVAL; /** The milliseconds between two mining progress reports, 0 disables them for headless runs */
+        static const std::string MINING_POOL_NAME; /** The POSIX shared-memory segment the processes of a local mining pool meet in */
+        static const unsigned long long MINING_POOL_RANGE_SIZE; /** The number of nonces a process of the mining pool claims at a time */
+        static const unsigned int VERIFY_THREADS; /** The number of threads verifying the chain, 0 uses every hardware thread */
+        static const std::string RECORD_POOL_FILE_PATH; /** The path to the sidecar file of the records waiting to be sealed into a block */
+        static const unsigned int RECORD_POOL_MAX_RECORDS; /** The number of pending records of a type that are sealed into one block */
+        static const unsigned int RECORD_POOL_MAX_AGE; /** The seconds the oldest pending record of a type waits before its records are sealed anyway */
     };
 } // namespace blockchain
 
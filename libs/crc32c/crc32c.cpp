@@ -0,0 +1,104 @@
+#include "crc32c.h"
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CRC32C_SSE42 1
+#include <immintrin.h>
+#else
+#define CRC32C_SSE42 0
+#endif
+
+// The reflected Castagnoli polynomial
+static constexpr uint32_t crc32c_polynomial = 0x82F63B78;
+
+// Table k gives the checksum of a byte followed by k zero bytes, so 8 bytes are folded per step
+struct Crc32cTables
+{
+    uint32_t slices[8][256] = {};
+
+    constexpr Crc32cTables()
+    {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ crc32c_polynomial : crc >> 1;
+            }
+            slices[0][i] = crc;
+        }
+        for (int k = 1; k < 8; k++) {
+            for (int i = 0; i < 256; i++) {
+                slices[k][i] = (slices[k - 1][i] >> 8) ^ slices[0][slices[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+// Built at compile time, so they are ready even for callers running during static initialization
+static constexpr Crc32cTables crc32c_tables;
+
+static uint32_t crc32c_slicing(uint32_t crc, const unsigned char *data, size_t len)
+{
+    while (len >= 8) {
+        uint32_t low;
+        uint32_t high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+        low ^= crc;
+        crc = crc32c_tables.slices[7][low & 0xFF] ^ crc32c_tables.slices[6][(low >> 8) & 0xFF] ^
+              crc32c_tables.slices[5][(low >> 16) & 0xFF] ^ crc32c_tables.slices[4][low >> 24] ^
+              crc32c_tables.slices[3][high & 0xFF] ^ crc32c_tables.slices[2][(high >> 8) & 0xFF] ^
+              crc32c_tables.slices[1][(high >> 16) & 0xFF] ^ crc32c_tables.slices[0][high >> 24];
+        data += 8;
+        len -= 8;
+    }
+    for (; len > 0; len--) {
+        crc = crc32c_tables.slices[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if CRC32C_SSE42
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const unsigned char *data, size_t len)
+{
+    uint64_t crc64 = crc;
+    while (len >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        len -= 8;
+    }
+    crc = (uint32_t) crc64;
+    for (; len > 0; len--) {
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+    return crc;
+}
+#endif
+
+bool Crc32c::isAccelerated()
+{
+#if CRC32C_SSE42
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+uint32_t Crc32c::extend(uint32_t crc, const unsigned char *data, size_t len)
+{
+    crc = ~crc;
+#if CRC32C_SSE42
+    if (isAccelerated()) {
+        return ~crc32c_sse42(crc, data, len);
+    }
+#endif
+    return ~crc32c_slicing(crc, data, len);
+}
+
+uint32_t Crc32c::compute(const unsigned char *data, size_t len)
+{
+    return extend(0, data, len);
+}
@@ -0,0 +1,30 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * CRC-32C (Castagnoli), the checksum of the records of the binary chain file.
+ * Uses the SSE4.2 crc32 instruction 8 bytes at a time when the CPU supports it, and falls back to
+ * slicing-by-8 lookup tables otherwise. Both give the same checksum, so files move freely between hosts.
+ */
+class Crc32c
+{
+public:
+    /**
+     * The checksum of len bytes.
+     */
+    static uint32_t compute(const unsigned char *data, size_t len);
+
+    /**
+     * Continue the checksum crc, of the bytes before, over len more bytes.
+     */
+    static uint32_t extend(uint32_t crc, const unsigned char *data, size_t len);
+
+    /**
+     * Whether the crc32 instruction is used on this CPU.
+     */
+    static bool isAccelerated();
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "hex.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HEX_SSSE3 1
+#include <immintrin.h>
+#else
+#define HEX_SSSE3 0
+#endif
+
+static constexpr char hex_digits[17] = "0123456789abcdef";
+
+// Both characters of every byte value, so encoding is one table load per byte
+struct HexEncodeTable
+{
+    char pairs[256][2] = {};
+
+    constexpr HexEncodeTable()
+    {
+        for (int i = 0; i < 256; i++) {
+            pairs[i][0] = hex_digits[i >> 4];
+            pairs[i][1] = hex_digits[i & 0x0F];
+        }
+    }
+};
+
+// The value of every character, or -1 for the ones that are not hexadecimal digits
+struct HexDecodeTable
+{
+    signed char values[256] = {};
+
+    constexpr HexDecodeTable()
+    {
+        for (int i = 0; i < 256; i++) {
+            values[i] = -1;
+        }
+        for (int i = 0; i < 10; i++) {
+            values['0' + i] = (signed char) i;
+        }
+        for (int i = 0; i < 6; i++) {
+            values['a' + i] = (signed char) (10 + i);
+            values['A' + i] = (signed char) (10 + i);
+        }
+    }
+};
+
+// Built at compile time, so they are ready even for callers running during static initialization
+static constexpr HexEncodeTable hex_encode_table;
+static constexpr HexDecodeTable hex_decode_table;
+
+#if HEX_SSSE3
+__attribute__((target("ssse3")))
+static size_t hex_encode_ssse3(const unsigned char *bytes, size_t len, char *out)
+{
+    const __m128i digits = _mm_loadu_si128((const __m128i *) hex_digits);
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    size_t i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i in = _mm_loadu_si128((const __m128i *) (bytes + i));
+        __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), low_mask));
+        __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(in, low_mask));
+        _mm_storeu_si128((__m128i *) (out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *) (out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return i;
+}
+
+// Map 16 characters to their values, setting the matching bit of invalid for each non-digit
+__attribute__((target("ssse3")))
+static inline __m128i hex_values_ssse3(__m128i in, int &invalid)
+{
+    __m128i digit = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+    __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(digit, _mm_set1_epi8(-1)),
+                                     _mm_cmplt_epi8(digit, _mm_set1_epi8(10)));
+    // Setting the case bit folds 'A'-'F' onto 'a'-'f'
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(letter, _mm_set1_epi8(-1)),
+                                      _mm_cmplt_epi8(letter, _mm_set1_epi8(6)));
+
+    invalid |= ~_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) & 0xFFFF;
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3")))
+static size_t hex_decode_ssse3(const char *hex, size_t len, unsigned char *out, bool &valid)
+{
+    // Multiplying the pairs by 16 and 1 and adding them gives the byte in each 16-bit lane
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    int invalid = 0;
+    size_t i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i first = hex_values_ssse3(_mm_loadu_si128((const __m128i *) (hex + 2 * i)), invalid);
+        __m128i second = hex_values_ssse3(_mm_loadu_si128((const __m128i *) (hex + 2 * i + 16)), invalid);
+        __m128i packed = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128((__m128i *) (out + i), packed);
+    }
+    valid = invalid == 0;
+    return i;
+}
+#endif
+
+bool Hex::isAccelerated()
+{
+#if HEX_SSSE3
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void Hex::encode(const unsigned char *bytes, size_t len, char *out)
+{
+    size_t i = 0;
+#if HEX_SSSE3
+    if (isAccelerated()) {
+        i = hex_encode_ssse3(bytes, len, out);
+    }
+#endif
+    for (; i < len; i++) {
+        out[2 * i] = hex_encode_table.pairs[bytes[i]][0];
+        out[2 * i + 1] = hex_encode_table.pairs[bytes[i]][1];
+    }
+}
+
+bool Hex::decode(const char *hex, size_t hex_len, unsigned char *out)
+{
+    if (hex_len % 2 != 0) {
+        return false;
+    }
+
+    size_t len = hex_len / 2;
+    size_t i = 0;
+#if HEX_SSSE3
+    if (isAccelerated()) {
+        bool valid;
+        i = hex_decode_ssse3(hex, len, out, valid);
+        if (!valid) {
+            return false;
+        }
+    }
+#endif
+    int invalid = 0;
+    for (; i < len; i++) {
+        signed char high = hex_decode_table.values[(unsigned char) hex[2 * i]];
+        signed char low = hex_decode_table.values[(unsigned char) hex[2 * i + 1]];
+        invalid |= high | low;
+        out[i] = (unsigned char) (((unsigned char) high << 4) | ((unsigned char) low & 0x0F));
+    }
+    return invalid >= 0;
+}
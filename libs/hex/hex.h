@@ -0,0 +1,32 @@
+#ifndef HEX_H
+#define HEX_H
+#include <cstddef>
+
+/**
+ * Table-driven hexadecimal codec for digests and other binary fields.
+ * Encodes and decodes 16 bytes per step with SSSE3 when the CPU supports it, which covers
+ * the 32, 48 and 64-byte SHA-2 digests without a scalar tail, and falls back to lookup tables otherwise.
+ * Both directions write into caller-provided buffers, so nothing is allocated.
+ */
+class Hex
+{
+public:
+    /**
+     * Write the lowercase hexadecimal representation of len bytes to out, which must hold 2 * len characters.
+     * No terminating null is written.
+     */
+    static void encode(const unsigned char *bytes, size_t len, char *out);
+
+    /**
+     * Parse hex_len hexadecimal characters, either case, into hex_len / 2 bytes of out.
+     * Returns false if hex_len is odd or a character is not a hexadecimal digit, out is then unspecified.
+     */
+    static bool decode(const char *hex, size_t hex_len, unsigned char *out);
+
+    /**
+     * Whether the vectorized kernels are used on this CPU.
+     */
+    static bool isAccelerated();
+};
+
+#endif
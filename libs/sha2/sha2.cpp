@@ -0,0 +1,91 @@
+#include <iostream>
+#include "../hex/hex.h"
+#include "sha2.h"
+#include "sha256_shani.h"
+
+template class SHA2<SHA256Parameters>;
+template class SHA2<SHA384Parameters>;
+template class SHA2<SHA512Parameters>;
+
+typedef void (*sha256_transform_function)(unsigned int *state, const unsigned char *message, unsigned int block_nb);
+
+static void sha256_generic_transform(unsigned int *state, const unsigned char *message, unsigned int block_nb)
+{
+    sha2_compress<SHA256Parameters>(state, message, block_nb);
+}
+
+static sha256_transform_function sha256_select_transform()
+{
+    if (!sha256_shani_supported()) {
+        return sha256_generic_transform;
+    }
+
+    // Self-test: both backends must agree on every block count and on a few states
+    unsigned char message[4 << 6];
+    unsigned int expected[8];
+    unsigned int actual[8];
+    unsigned int block_nb;
+    int i;
+    for (i = 0; i < (int) sizeof(message); i++) {
+        message[i] = (unsigned char) (i * 131 + 7);
+    }
+    for (block_nb = 0; block_nb <= 4; block_nb++) {
+        for (i = 0; i < 8; i++) {
+            expected[i] = actual[i] = 0x9e3779b9u * (unsigned int) (i + block_nb + 1);
+        }
+        sha256_generic_transform(expected, message, block_nb);
+        sha256_shani_transform(actual, message, block_nb);
+        if (memcmp(expected, actual, sizeof(expected)) != 0) {
+            std::cerr << "SHA-256: SHA-NI self-test failed, using the portable implementation." << std::endl;
+            return sha256_generic_transform;
+        }
+    }
+    return sha256_shani_transform;
+}
+
+void SHA256Parameters::compress(word *state, const unsigned char *message, size_t block_nb)
+{
+    static const sha256_transform_function backend = sha256_select_transform();
+    // The backends count blocks in 32 bits, so long messages are fed 1 GiB at a time
+    while (block_nb > 0) {
+        unsigned int chunk_nb = block_nb < (1u << 24) ? (unsigned int) block_nb : (1u << 24);
+        backend(state, message, chunk_nb);
+        message += (size_t) chunk_nb * BLOCK_SIZE;
+        block_nb -= chunk_nb;
+    }
+}
+
+bool SHA256Parameters::is_hardware_accelerated()
+{
+    static const bool accelerated = sha256_select_transform() == sha256_shani_transform;
+    return accelerated;
+}
+
+template <typename Parameters>
+static std::string sha2_hex(const std::string &input)
+{
+    unsigned char digest[Parameters::DIGEST_SIZE];
+    SHA2<Parameters> ctx = SHA2<Parameters>();
+    ctx.init();
+    ctx.update((const unsigned char *) input.data(), input.length());
+    ctx.final(digest);
+
+    std::string hex(2 * Parameters::DIGEST_SIZE, '0');
+    Hex::encode(digest, Parameters::DIGEST_SIZE, &hex[0]);
+    return hex;
+}
+
+std::string sha256(const std::string &input)
+{
+    return sha2_hex<SHA256Parameters>(input);
+}
+
+std::string sha384(const std::string &input)
+{
+    return sha2_hex<SHA384Parameters>(input);
+}
+
+std::string sha512(const std::string &input)
+{
+    return sha2_hex<SHA512Parameters>(input);
+}
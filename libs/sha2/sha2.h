@@ -0,0 +1,335 @@
+#ifndef SHA2_H
+#define SHA2_H
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+
+/*
+ * Big-endian word access. On little-endian GCC and Clang targets a load or store is a single
+ * unaligned move plus a bswap, instead of four or eight byte loads, shifts and ors.
+ */
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SHA2_BSWAP 1
+#else
+#define SHA2_BSWAP 0
+#endif
+
+inline unsigned int sha2_load_be32(const unsigned char *str)
+{
+#if SHA2_BSWAP
+    unsigned int x;
+    memcpy(&x, str, sizeof(x));
+    return __builtin_bswap32(x);
+#else
+    return ((unsigned int) str[3])
+           | ((unsigned int) str[2] <<  8)
+           | ((unsigned int) str[1] << 16)
+           | ((unsigned int) str[0] << 24);
+#endif
+}
+
+inline unsigned long long sha2_load_be64(const unsigned char *str)
+{
+#if SHA2_BSWAP
+    unsigned long long x;
+    memcpy(&x, str, sizeof(x));
+    return __builtin_bswap64(x);
+#else
+    return ((unsigned long long) sha2_load_be32(str) << 32) | sha2_load_be32(str + 4);
+#endif
+}
+
+inline void sha2_store_be32(unsigned int x, unsigned char *str)
+{
+#if SHA2_BSWAP
+    x = __builtin_bswap32(x);
+    memcpy(str, &x, sizeof(x));
+#else
+    str[0] = (unsigned char) (x >> 24);
+    str[1] = (unsigned char) (x >> 16);
+    str[2] = (unsigned char) (x >>  8);
+    str[3] = (unsigned char) (x      );
+#endif
+}
+
+inline void sha2_store_be64(unsigned long long x, unsigned char *str)
+{
+#if SHA2_BSWAP
+    x = __builtin_bswap64(x);
+    memcpy(str, &x, sizeof(x));
+#else
+    sha2_store_be32((unsigned int) (x >> 32), str);
+    sha2_store_be32((unsigned int) x, str + 4);
+#endif
+}
+
+/*
+ * What sets the members of the family apart: the word size, the round constants and functions,
+ * the initial hash value and the compression backend. SHA-384 is SHA-512 with another initial
+ * hash value and a truncated digest.
+ */
+struct SHA256Parameters
+{
+    typedef unsigned int word;
+
+    static const unsigned int BLOCK_SIZE = (512 / 8);
+    static const unsigned int DIGEST_SIZE = (256 / 8);
+    static const unsigned int ROUNDS = 64;
+
+    alignas(16) static constexpr word K[ROUNDS] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    static constexpr word IV[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    static constexpr word rotr(word x, unsigned int n) { return (x >> n) | (x << (32 - n)); }
+    static constexpr word sum0(word x) { return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22); }
+    static constexpr word sum1(word x) { return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25); }
+    static constexpr word sigma0(word x) { return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3); }
+    static constexpr word sigma1(word x) { return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10); }
+    static word load(const unsigned char *str) { return sha2_load_be32(str); }
+    static void store(word x, unsigned char *str) { sha2_store_be32(x, str); }
+
+    /**
+     * Compress block_nb consecutive blocks into state.
+     * The backend is picked once, on first use: SHA-NI if the CPU has it and it
+     * passes a self-test against the portable code, the portable code otherwise.
+     */
+    static void compress(word *state, const unsigned char *message, size_t block_nb);
+
+    /**
+     * Whether compress runs on the SHA extensions of the CPU.
+     */
+    static bool is_hardware_accelerated();
+};
+
+struct SHA512Parameters
+{
+    typedef unsigned long long word;
+
+    static const unsigned int BLOCK_SIZE = (1024 / 8);
+    static const unsigned int DIGEST_SIZE = (512 / 8);
+    static const unsigned int ROUNDS = 80;
+
+    alignas(32) static constexpr word K[ROUNDS] = {
+            0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+            0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+            0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+            0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+            0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+            0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+            0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+            0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+            0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+            0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+            0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+            0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+            0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+            0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+            0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+            0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+            0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+            0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+            0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+            0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+    static constexpr word IV[8] = {
+            0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+            0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+
+    static constexpr word rotr(word x, unsigned int n) { return (x >> n) | (x << (64 - n)); }
+    static constexpr word sum0(word x) { return rotr(x, 28) ^ rotr(x, 34) ^ rotr(x, 39); }
+    static constexpr word sum1(word x) { return rotr(x, 14) ^ rotr(x, 18) ^ rotr(x, 41); }
+    static constexpr word sigma0(word x) { return rotr(x, 1) ^ rotr(x, 8) ^ (x >> 7); }
+    static constexpr word sigma1(word x) { return rotr(x, 19) ^ rotr(x, 61) ^ (x >> 6); }
+    static word load(const unsigned char *str) { return sha2_load_be64(str); }
+    static void store(word x, unsigned char *str) { sha2_store_be64(x, str); }
+
+    /**
+     * Compress block_nb consecutive blocks into state with the portable code.
+     */
+    static void compress(word *state, const unsigned char *message, size_t block_nb);
+};
+
+struct SHA384Parameters : SHA512Parameters
+{
+    static const unsigned int DIGEST_SIZE = (384 / 8);
+
+    static constexpr word IV[8] = {
+            0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+            0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL};
+};
+
+/*
+ * Round R of the compression function. Instead of shifting the eight working variables
+ * down after every round, each round names them at slots rotated by R, so the fully
+ * unrolled rounds below keep all of them in registers without any moves.
+ */
+template <typename Parameters, unsigned int R>
+inline void sha2_round(typename Parameters::word *v, const typename Parameters::word *w)
+{
+    typedef typename Parameters::word word;
+    const word a = v[(0 - R) & 7];
+    const word b = v[(1 - R) & 7];
+    const word c = v[(2 - R) & 7];
+    word &d = v[(3 - R) & 7];
+    const word e = v[(4 - R) & 7];
+    const word f = v[(5 - R) & 7];
+    const word g = v[(6 - R) & 7];
+    word &h = v[(7 - R) & 7];
+
+    const word t1 = h + Parameters::sum1(e) + ((e & f) ^ (~e & g)) + Parameters::K[R] + w[R];
+    const word t2 = Parameters::sum0(a) + ((a & b) ^ (a & c) ^ (b & c));
+    d += t1;
+    h = t1 + t2;
+}
+
+template <typename Parameters, unsigned int... R>
+inline void sha2_rounds(typename Parameters::word *v, const typename Parameters::word *w,
+                        std::integer_sequence<unsigned int, R...>)
+{
+    (sha2_round<Parameters, R>(v, w), ...);
+}
+
+/*
+ * The portable compression function of every member of the family.
+ */
+template <typename Parameters>
+inline void sha2_compress(typename Parameters::word *state, const unsigned char *message, size_t block_nb)
+{
+    typedef typename Parameters::word word;
+    word w[Parameters::ROUNDS];
+    word v[8];
+    size_t i;
+    unsigned int j;
+    for (i = 0; i < block_nb; i++) {
+        const unsigned char *sub_block = message + i * Parameters::BLOCK_SIZE;
+        for (j = 0; j < 16; j++) {
+            w[j] = Parameters::load(sub_block + j * sizeof(word));
+        }
+        for (j = 16; j < Parameters::ROUNDS; j++) {
+            w[j] = Parameters::sigma1(w[j - 2]) + w[j - 7] + Parameters::sigma0(w[j - 15]) + w[j - 16];
+        }
+        memcpy(v, state, sizeof(v));
+        sha2_rounds<Parameters>(v, w, std::make_integer_sequence<unsigned int, Parameters::ROUNDS>());
+        for (j = 0; j < 8; j++) {
+            state[j] += v[j];
+        }
+    }
+}
+
+inline void SHA512Parameters::compress(word *state, const unsigned char *message, size_t block_nb)
+{
+    sha2_compress<SHA512Parameters>(state, message, block_nb);
+}
+
+/*
+ * Streaming SHA-2 context. Messages may be fed in any number of pieces, and lengths
+ * are 64-bit throughout, so messages of more than 4 GiB can be hashed.
+ */
+template <typename Parameters>
+class SHA2
+{
+    friend class SHA256x8;
+    friend class SHA512x4;
+
+protected:
+    typedef typename Parameters::word word;
+
+public:
+    static const unsigned int BLOCK_SIZE = Parameters::BLOCK_SIZE;
+    static const unsigned int DIGEST_SIZE = Parameters::DIGEST_SIZE;
+
+    void init();
+    void update(const unsigned char *message, size_t len);
+    void final(unsigned char *digest);
+
+protected:
+    unsigned long long m_tot_len;
+    unsigned int m_len;
+    unsigned char m_block[2 * BLOCK_SIZE];
+    word m_h[8];
+};
+
+template <typename Parameters>
+void SHA2<Parameters>::init()
+{
+    memcpy(m_h, Parameters::IV, sizeof(m_h));
+    m_len = 0;
+    m_tot_len = 0;
+}
+
+template <typename Parameters>
+void SHA2<Parameters>::update(const unsigned char *message, size_t len)
+{
+    size_t block_nb;
+    size_t new_len, rem_len, tmp_len;
+    const unsigned char *shifted_message;
+    tmp_len = BLOCK_SIZE - m_len;
+    rem_len = len < tmp_len ? len : tmp_len;
+    memcpy(&m_block[m_len], message, rem_len);
+    if (m_len + len < BLOCK_SIZE) {
+        m_len += (unsigned int) len;
+        return;
+    }
+    new_len = len - rem_len;
+    block_nb = new_len / BLOCK_SIZE;
+    shifted_message = message + rem_len;
+    Parameters::compress(m_h, m_block, 1);
+    Parameters::compress(m_h, shifted_message, block_nb);
+    rem_len = new_len % BLOCK_SIZE;
+    memcpy(m_block, &shifted_message[block_nb * BLOCK_SIZE], rem_len);
+    m_len = (unsigned int) rem_len;
+    m_tot_len += (unsigned long long) (block_nb + 1) * BLOCK_SIZE;
+}
+
+template <typename Parameters>
+void SHA2<Parameters>::final(unsigned char *digest)
+{
+    // The bit count takes two words at the end of the last block
+    const unsigned int length_size = 2 * sizeof(word);
+    const unsigned long long total = m_tot_len + m_len;
+    unsigned int block_nb;
+    unsigned int pm_len;
+    unsigned int i;
+    block_nb = (1 + ((BLOCK_SIZE - length_size - 1) < (m_len % BLOCK_SIZE)));
+    pm_len = block_nb * BLOCK_SIZE;
+    memset(m_block + m_len, 0, pm_len - m_len);
+    m_block[m_len] = 0x80;
+    // The upper half of the 128-bit field of SHA-384/512 only holds the top bits of the bit count
+    if (length_size > 8) {
+        sha2_store_be64(total >> 61, m_block + pm_len - 16);
+    }
+    sha2_store_be64(total << 3, m_block + pm_len - 8);
+    Parameters::compress(m_h, m_block, block_nb);
+    for (i = 0; i < DIGEST_SIZE / sizeof(word); i++) {
+        Parameters::store(m_h[i], &digest[i * sizeof(word)]);
+    }
+}
+
+typedef SHA2<SHA256Parameters> SHA256;
+typedef SHA2<SHA384Parameters> SHA384;
+typedef SHA2<SHA512Parameters> SHA512;
+
+// Instantiated once, in sha2.cpp
+extern template class SHA2<SHA256Parameters>;
+extern template class SHA2<SHA384Parameters>;
+extern template class SHA2<SHA512Parameters>;
+
+/*
+ * One-shot hashes of a string, as lowercase hexadecimal.
+ */
+std::string sha256(const std::string &input);
+std::string sha384(const std::string &input);
+std::string sha512(const std::string &input);
+
+#endif
@@ -0,0 +1,74 @@
+#include "sha2.h"
+#include "sha256_shani.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_SHANI 1
+#include <immintrin.h>
+#else
+#define SHA256_SHANI 0
+#endif
+
+bool sha256_shani_supported()
+{
+#if SHA256_SHANI
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+#else
+    return false;
+#endif
+}
+
+#if SHA256_SHANI
+__attribute__((target("sha,sse4.1")))
+void sha256_shani_transform(unsigned int *state, const unsigned char *message, unsigned int block_nb)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef_save, cdgh_save, tmp, kw;
+    __m128i w[4];
+    int i;
+
+    // The rounds instructions want the state as ABEF / CDGH
+    tmp = _mm_loadu_si128((const __m128i *) &state[0]);
+    state1 = _mm_loadu_si128((const __m128i *) &state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (block_nb--) {
+        abef_save = state0;
+        cdgh_save = state1;
+
+        // Sixteen groups of four rounds, the schedule keeps the last four message quads
+        for (i = 0; i < 16; i++) {
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (message + (i << 4))), byte_swap);
+            } else {
+                tmp = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+                tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(tmp, w[(i + 3) & 3]);
+            }
+            kw = _mm_add_epi32(w[i & 3], _mm_load_si128((const __m128i *) &SHA256Parameters::K[i << 2]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, kw);
+            kw = _mm_shuffle_epi32(kw, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, kw);
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        message += 64;
+    }
+
+    // Back to ABCD / EFGH
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *) &state[0], state0);
+    _mm_storeu_si128((__m128i *) &state[4], state1);
+}
+#else
+void sha256_shani_transform(unsigned int *, const unsigned char *, unsigned int)
+{
+}
+#endif
@@ -0,0 +1,11 @@
+#ifndef SHA256_SHANI_H
+#define SHA256_SHANI_H
+
+/**
+ * SHA-256 compression on the x86 SHA extensions (SHA-NI).
+ * Only call sha256_shani_transform when sha256_shani_supported() returns true.
+ */
+bool sha256_shani_supported();
+void sha256_shani_transform(unsigned int *state, const unsigned char *message, unsigned int block_nb);
+
+#endif
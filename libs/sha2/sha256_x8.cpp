@@ -0,0 +1,147 @@
+#include <cstring>
+#include <vector>
+#include "sha256_x8.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_X8_AVX2 1
+#include <immintrin.h>
+#else
+#define SHA256_X8_AVX2 0
+#endif
+
+#if SHA256_X8_AVX2
+#define SHA256_X8_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define SHA256_X8_F1(x) _mm256_xor_si256(_mm256_xor_si256(SHA256_X8_ROTR(x,  2), SHA256_X8_ROTR(x, 13)), SHA256_X8_ROTR(x, 22))
+#define SHA256_X8_F2(x) _mm256_xor_si256(_mm256_xor_si256(SHA256_X8_ROTR(x,  6), SHA256_X8_ROTR(x, 11)), SHA256_X8_ROTR(x, 25))
+#define SHA256_X8_F3(x) _mm256_xor_si256(_mm256_xor_si256(SHA256_X8_ROTR(x,  7), SHA256_X8_ROTR(x, 18)), _mm256_srli_epi32((x),  3))
+#define SHA256_X8_F4(x) _mm256_xor_si256(_mm256_xor_si256(SHA256_X8_ROTR(x, 17), SHA256_X8_ROTR(x, 19)), _mm256_srli_epi32((x), 10))
+#define SHA256_X8_CH(x, y, z)  _mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define SHA256_X8_MAJ(x, y, z) _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_and_si256((x), (z))), _mm256_and_si256((y), (z)))
+
+/*
+ * Compress one 64-byte block per lane. state[lane][word] is updated in place.
+ */
+__attribute__((target("avx2")))
+static void sha256_x8_transform_avx2(unsigned int state[][8], const unsigned char *const blocks[SHA256x8::LANES])
+{
+    __m256i w[16];
+    __m256i wv[8];
+    __m256i t1, t2;
+    alignas(32) unsigned int lanes[8];
+    int i, j;
+
+    for (j = 0; j < 16; j++) {
+        w[j] = _mm256_setr_epi32(
+                (int) sha2_load_be32(blocks[0] + (j << 2)), (int) sha2_load_be32(blocks[1] + (j << 2)),
+                (int) sha2_load_be32(blocks[2] + (j << 2)), (int) sha2_load_be32(blocks[3] + (j << 2)),
+                (int) sha2_load_be32(blocks[4] + (j << 2)), (int) sha2_load_be32(blocks[5] + (j << 2)),
+                (int) sha2_load_be32(blocks[6] + (j << 2)), (int) sha2_load_be32(blocks[7] + (j << 2)));
+    }
+    for (j = 0; j < 8; j++) {
+        wv[j] = _mm256_setr_epi32((int) state[0][j], (int) state[1][j], (int) state[2][j], (int) state[3][j],
+                                  (int) state[4][j], (int) state[5][j], (int) state[6][j], (int) state[7][j]);
+    }
+    for (j = 0; j < 64; j++) {
+        if (j >= 16) {
+            w[j & 15] = _mm256_add_epi32(_mm256_add_epi32(SHA256_X8_F4(w[(j - 2) & 15]), w[(j - 7) & 15]),
+                                         _mm256_add_epi32(SHA256_X8_F3(w[(j - 15) & 15]), w[j & 15]));
+        }
+        t1 = _mm256_add_epi32(_mm256_add_epi32(wv[7], SHA256_X8_F2(wv[4])),
+                              _mm256_add_epi32(SHA256_X8_CH(wv[4], wv[5], wv[6]),
+                                               _mm256_add_epi32(_mm256_set1_epi32((int) SHA256Parameters::K[j]), w[j & 15])));
+        t2 = _mm256_add_epi32(SHA256_X8_F1(wv[0]), SHA256_X8_MAJ(wv[0], wv[1], wv[2]));
+        wv[7] = wv[6];
+        wv[6] = wv[5];
+        wv[5] = wv[4];
+        wv[4] = _mm256_add_epi32(wv[3], t1);
+        wv[3] = wv[2];
+        wv[2] = wv[1];
+        wv[1] = wv[0];
+        wv[0] = _mm256_add_epi32(t1, t2);
+    }
+    for (j = 0; j < 8; j++) {
+        _mm256_store_si256((__m256i *) lanes, wv[j]);
+        for (i = 0; i < 8; i++) {
+            state[i][j] += lanes[i];
+        }
+    }
+}
+#endif
+
+bool SHA256x8::isAccelerated()
+{
+#if SHA256_X8_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void SHA256x8::finalFromMidstate(const SHA256 &midstate, const unsigned char *const suffixes[LANES],
+                                 size_t suffix_len, unsigned char digests[LANES][SHA256::DIGEST_SIZE])
+{
+    unsigned int lane;
+#if SHA256_X8_AVX2
+    if (isAccelerated()) {
+        unsigned int state[LANES][8];
+        const unsigned char *blocks[LANES];
+        size_t msg_len = midstate.m_len + suffix_len;
+        size_t pm_len = ((msg_len + 8) / SHA256::BLOCK_SIZE + 1) * SHA256::BLOCK_SIZE;
+        unsigned long long len_b = ((unsigned long long) midstate.m_tot_len + msg_len) << 3;
+        unsigned char small_tails[LANES][2 * SHA256::BLOCK_SIZE];
+        std::vector<unsigned char> large_tails;
+        unsigned char *tails = &small_tails[0][0];
+        size_t offset;
+        int i;
+
+        if (pm_len > sizeof(small_tails[0])) {
+            large_tails.resize(LANES * pm_len);
+            tails = large_tails.data();
+        }
+
+        // Lay out buffered bytes + suffix + padding + bit length for every lane
+        for (lane = 0; lane < LANES; lane++) {
+            unsigned char *tail = tails + lane * pm_len;
+            memcpy(tail, midstate.m_block, midstate.m_len);
+            memcpy(tail + midstate.m_len, suffixes[lane], suffix_len);
+            memset(tail + msg_len, 0, pm_len - msg_len);
+            tail[msg_len] = 0x80;
+            for (i = 0; i < 8; i++) {
+                tail[pm_len - 1 - i] = (unsigned char) (len_b >> (i << 3));
+            }
+            memcpy(state[lane], midstate.m_h, sizeof(state[lane]));
+        }
+
+        for (offset = 0; offset < pm_len; offset += SHA256::BLOCK_SIZE) {
+            for (lane = 0; lane < LANES; lane++) {
+                blocks[lane] = tails + lane * pm_len + offset;
+            }
+            sha256_x8_transform_avx2(state, blocks);
+        }
+
+        for (lane = 0; lane < LANES; lane++) {
+            for (i = 0; i < 8; i++) {
+                digests[lane][(i << 2) + 0] = (unsigned char) (state[lane][i] >> 24);
+                digests[lane][(i << 2) + 1] = (unsigned char) (state[lane][i] >> 16);
+                digests[lane][(i << 2) + 2] = (unsigned char) (state[lane][i] >>  8);
+                digests[lane][(i << 2) + 3] = (unsigned char) (state[lane][i]      );
+            }
+        }
+        return;
+    }
+#endif
+    for (lane = 0; lane < LANES; lane++) {
+        SHA256 ctx = midstate;
+        ctx.update(suffixes[lane], suffix_len);
+        ctx.final(digests[lane]);
+    }
+}
+
+void SHA256x8::hash(const unsigned char *const messages[LANES], size_t len,
+                    unsigned char digests[LANES][SHA256::DIGEST_SIZE])
+{
+    SHA256 ctx = SHA256();
+    ctx.init();
+    finalFromMidstate(ctx, messages, len, digests);
+}
@@ -0,0 +1,34 @@
+#ifndef SHA256_X8_H
+#define SHA256_X8_H
+#include "sha2.h"
+
+/**
+ * Multi-buffer SHA-256: hashes eight independent messages per call.
+ * Runs the rounds on the eight lanes of an AVX2 register when the CPU supports it,
+ * and falls back to the scalar SHA256 class one message at a time otherwise.
+ */
+class SHA256x8
+{
+public:
+    static const unsigned int LANES = 8;
+
+    /**
+     * Finish eight copies of a midstate, each fed its own suffix of the same length.
+     * Digest i equals SHA256 of (the data absorbed by midstate) followed by suffixes[i].
+     */
+    static void finalFromMidstate(const SHA256 &midstate, const unsigned char *const suffixes[LANES],
+                                  size_t suffix_len, unsigned char digests[LANES][SHA256::DIGEST_SIZE]);
+
+    /**
+     * Hash eight independent messages of the same length.
+     */
+    static void hash(const unsigned char *const messages[LANES], size_t len,
+                     unsigned char digests[LANES][SHA256::DIGEST_SIZE]);
+
+    /**
+     * Whether the vectorized kernel is used on this CPU.
+     */
+    static bool isAccelerated();
+};
+
+#endif
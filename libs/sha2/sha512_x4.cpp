@@ -0,0 +1,165 @@
+#include <cstring>
+#include <vector>
+#include "sha512_x4.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA512_X4_AVX2 1
+#include <immintrin.h>
+#else
+#define SHA512_X4_AVX2 0
+#endif
+
+#if SHA512_X4_AVX2
+#define SHA512_X4_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+#define SHA512_X4_F1(x) _mm256_xor_si256(_mm256_xor_si256(SHA512_X4_ROTR(x, 28), SHA512_X4_ROTR(x, 34)), SHA512_X4_ROTR(x, 39))
+#define SHA512_X4_F2(x) _mm256_xor_si256(_mm256_xor_si256(SHA512_X4_ROTR(x, 14), SHA512_X4_ROTR(x, 18)), SHA512_X4_ROTR(x, 41))
+#define SHA512_X4_F3(x) _mm256_xor_si256(_mm256_xor_si256(SHA512_X4_ROTR(x,  1), SHA512_X4_ROTR(x,  8)), _mm256_srli_epi64((x),  7))
+#define SHA512_X4_F4(x) _mm256_xor_si256(_mm256_xor_si256(SHA512_X4_ROTR(x, 19), SHA512_X4_ROTR(x, 61)), _mm256_srli_epi64((x),  6))
+#define SHA512_X4_CH(x, y, z)  _mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define SHA512_X4_MAJ(x, y, z) _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_and_si256((x), (z))), _mm256_and_si256((y), (z)))
+
+/*
+ * Compress one 128-byte block per lane. state[lane][word] is updated in place.
+ */
+__attribute__((target("avx2")))
+static void sha512_x4_transform_avx2(unsigned long long state[][8], const unsigned char *const blocks[SHA512x4::LANES])
+{
+    __m256i w[16];
+    __m256i wv[8];
+    __m256i t1, t2;
+    alignas(32) unsigned long long lanes[4];
+    int i, j;
+
+    for (j = 0; j < 16; j++) {
+        w[j] = _mm256_setr_epi64x(
+                (long long) sha2_load_be64(blocks[0] + (j << 3)), (long long) sha2_load_be64(blocks[1] + (j << 3)),
+                (long long) sha2_load_be64(blocks[2] + (j << 3)), (long long) sha2_load_be64(blocks[3] + (j << 3)));
+    }
+    for (j = 0; j < 8; j++) {
+        wv[j] = _mm256_setr_epi64x((long long) state[0][j], (long long) state[1][j],
+                                   (long long) state[2][j], (long long) state[3][j]);
+    }
+    for (j = 0; j < 80; j++) {
+        if (j >= 16) {
+            w[j & 15] = _mm256_add_epi64(_mm256_add_epi64(SHA512_X4_F4(w[(j - 2) & 15]), w[(j - 7) & 15]),
+                                         _mm256_add_epi64(SHA512_X4_F3(w[(j - 15) & 15]), w[j & 15]));
+        }
+        t1 = _mm256_add_epi64(_mm256_add_epi64(wv[7], SHA512_X4_F2(wv[4])),
+                              _mm256_add_epi64(SHA512_X4_CH(wv[4], wv[5], wv[6]),
+                                               _mm256_add_epi64(_mm256_set1_epi64x((long long) SHA512Parameters::K[j]), w[j & 15])));
+        t2 = _mm256_add_epi64(SHA512_X4_F1(wv[0]), SHA512_X4_MAJ(wv[0], wv[1], wv[2]));
+        wv[7] = wv[6];
+        wv[6] = wv[5];
+        wv[5] = wv[4];
+        wv[4] = _mm256_add_epi64(wv[3], t1);
+        wv[3] = wv[2];
+        wv[2] = wv[1];
+        wv[1] = wv[0];
+        wv[0] = _mm256_add_epi64(t1, t2);
+    }
+    for (j = 0; j < 8; j++) {
+        _mm256_store_si256((__m256i *) lanes, wv[j]);
+        for (i = 0; i < 4; i++) {
+            state[i][j] += lanes[i];
+        }
+    }
+}
+#endif
+
+bool SHA512x4::isAccelerated()
+{
+#if SHA512_X4_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+template <typename Context>
+void SHA512x4::finish(const Context &midstate, const unsigned char *const suffixes[LANES],
+                      size_t suffix_len, unsigned char *digests, unsigned int digest_size)
+{
+    unsigned int lane;
+#if SHA512_X4_AVX2
+    if (isAccelerated()) {
+        const unsigned int block_size = Context::BLOCK_SIZE;
+        unsigned long long state[LANES][8];
+        const unsigned char *blocks[LANES];
+        size_t msg_len = midstate.m_len + suffix_len;
+        size_t pm_len = ((msg_len + 16) / block_size + 1) * block_size;
+        unsigned long long len_b = ((unsigned long long) midstate.m_tot_len + msg_len) << 3;
+        unsigned char small_tails[LANES][2 * block_size];
+        std::vector<unsigned char> large_tails;
+        unsigned char *tails = &small_tails[0][0];
+        size_t offset;
+        unsigned int i;
+
+        if (pm_len > sizeof(small_tails[0])) {
+            large_tails.resize(LANES * pm_len);
+            tails = large_tails.data();
+        }
+
+        // Lay out buffered bytes + suffix + padding + bit length for every lane
+        for (lane = 0; lane < LANES; lane++) {
+            unsigned char *tail = tails + lane * pm_len;
+            memcpy(tail, midstate.m_block, midstate.m_len);
+            memcpy(tail + midstate.m_len, suffixes[lane], suffix_len);
+            memset(tail + msg_len, 0, pm_len - msg_len);
+            tail[msg_len] = 0x80;
+            for (i = 0; i < 8; i++) {
+                tail[pm_len - 1 - i] = (unsigned char) (len_b >> (i << 3));
+            }
+            memcpy(state[lane], midstate.m_h, sizeof(state[lane]));
+        }
+
+        for (offset = 0; offset < pm_len; offset += block_size) {
+            for (lane = 0; lane < LANES; lane++) {
+                blocks[lane] = tails + lane * pm_len + offset;
+            }
+            sha512_x4_transform_avx2(state, blocks);
+        }
+
+        // SHA-384 keeps the first six words, SHA-512 all eight
+        for (lane = 0; lane < LANES; lane++) {
+            for (i = 0; i < digest_size; i++) {
+                digests[lane * digest_size + i] = (unsigned char) (state[lane][i >> 3] >> ((7 - (i & 7)) << 3));
+            }
+        }
+        return;
+    }
+#endif
+    for (lane = 0; lane < LANES; lane++) {
+        Context ctx = midstate;
+        ctx.update(suffixes[lane], suffix_len);
+        ctx.final(digests + lane * digest_size);
+    }
+}
+
+void SHA512x4::finalFromMidstate(const SHA512 &midstate, const unsigned char *const suffixes[LANES],
+                                 size_t suffix_len, unsigned char digests[LANES][SHA512::DIGEST_SIZE])
+{
+    finish(midstate, suffixes, suffix_len, &digests[0][0], SHA512::DIGEST_SIZE);
+}
+
+void SHA512x4::finalFromMidstate(const SHA384 &midstate, const unsigned char *const suffixes[LANES],
+                                 size_t suffix_len, unsigned char digests[LANES][SHA384::DIGEST_SIZE])
+{
+    finish(midstate, suffixes, suffix_len, &digests[0][0], SHA384::DIGEST_SIZE);
+}
+
+void SHA512x4::hash512(const unsigned char *const messages[LANES], size_t len,
+                       unsigned char digests[LANES][SHA512::DIGEST_SIZE])
+{
+    SHA512 ctx = SHA512();
+    ctx.init();
+    finalFromMidstate(ctx, messages, len, digests);
+}
+
+void SHA512x4::hash384(const unsigned char *const messages[LANES], size_t len,
+                       unsigned char digests[LANES][SHA384::DIGEST_SIZE])
+{
+    SHA384 ctx = SHA384();
+    ctx.init();
+    finalFromMidstate(ctx, messages, len, digests);
+}
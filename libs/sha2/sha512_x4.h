@@ -0,0 +1,42 @@
+#ifndef SHA512_X4_H
+#define SHA512_X4_H
+#include "sha2.h"
+
+/**
+ * Multi-buffer SHA-512 / SHA-384: hashes four independent messages per call.
+ * Both digests share the 64-bit compression function, which runs on the four lanes
+ * of an AVX2 register when the CPU supports it. Falls back to the scalar classes otherwise.
+ */
+class SHA512x4
+{
+public:
+    static const unsigned int LANES = 4;
+
+    /**
+     * Finish four copies of a midstate, each fed its own suffix of the same length.
+     */
+    static void finalFromMidstate(const SHA512 &midstate, const unsigned char *const suffixes[LANES],
+                                  size_t suffix_len, unsigned char digests[LANES][SHA512::DIGEST_SIZE]);
+    static void finalFromMidstate(const SHA384 &midstate, const unsigned char *const suffixes[LANES],
+                                  size_t suffix_len, unsigned char digests[LANES][SHA384::DIGEST_SIZE]);
+
+    /**
+     * Hash four independent messages of the same length.
+     */
+    static void hash512(const unsigned char *const messages[LANES], size_t len,
+                        unsigned char digests[LANES][SHA512::DIGEST_SIZE]);
+    static void hash384(const unsigned char *const messages[LANES], size_t len,
+                        unsigned char digests[LANES][SHA384::DIGEST_SIZE]);
+
+    /**
+     * Whether the vectorized kernel is used on this CPU.
+     */
+    static bool isAccelerated();
+
+private:
+    template <typename Context>
+    static void finish(const Context &midstate, const unsigned char *const suffixes[LANES],
+                       size_t suffix_len, unsigned char *digests, unsigned int digest_size);
+};
+
+#endif
@@ -1,19 +1,33 @@
 #include "Application.h"
 #include "blockchain/Chain.h"
+#include "blockchain/mining/MiningCheckpoint.h"
+#include "blockchain/mining/MiningEngine.h"
+#include "blockchain/mining/MiningPool.h"
+#include "blockchain/mining/MiningService.h"
+#include "blockchain/pool/RecordPool.h"
+#include "filesystem/ChainStore.h"
 #include "filesystem/FileReader.h"
 #include "../data/Config.h"
 #include "authentication/Login.h"
 #include "collection/InputCollector.h"
 #include "collection/conversion/DataConverter.h"
 #include "collection/validator/InputValidator.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <functional>
+#include <cstdlib>
 
 // Static member variable initialization
 blockchain::Chain* Application::blockchain = nullptr;
 blockchain::Chain* Application::redactedBlockchain = nullptr;
+blockchain::mining::MiningService* Application::miningService = nullptr;
+blockchain::mining::MiningPool* Application::miningPool = nullptr;
+blockchain::mining::MiningCheckpoint* Application::miningCheckpoint = nullptr;
+blockchain::pool::RecordPool* Application::recordPool = nullptr;
+bool Application::coordinatesMiningPool = false;
 std::vector<authentication::Participant> Application::participants;
 std::unique_ptr<authentication::Participant> Application::currentParticipant = nullptr;
 std::vector<filesystem::BlockData> Application::blocks;
@@ -24,19 +38,95 @@ void Application::init() {
     initDependencies();
 
     initializeBlockchain();
+    initRecordPool(); // Opened first, so it checks its batches against every checkpoint before a resumed job drops its own
+    resumeMiningJobs();
+}
+
+int Application::convertChainFile(const std::string& sourcePath, const std::string& targetPath, const std::string& format) {
+    try {
+        size_t count = filesystem::ChainStore::convert(sourcePath, targetPath, filesystem::ChainStore::parseFormat(format));
+        std::cout << "Converted " << count << " blocks from " << sourcePath << " to " << targetPath << " in the " << format << " format." << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int Application::runMiningPoolWorker() {
+    initMiningOptions();
+    return blockchain::mining::MiningPool::runWorker(data::Config::MINING_POOL_NAME);
+}
+
+void Application::initMiningOptions() {
+    /**
+     * @brief The number of threads every block is mined with, and the share of the CPU they may take.
+     */
+    blockchain::mining::MiningOptions miningOptions;
+    miningOptions.threads = data::Config::MINING_THREADS;
+    miningOptions.dutyCycle = data::Config::MINING_DUTY_CYCLE;
+    miningOptions.niceness = data::Config::MINING_NICENESS;
+    miningOptions.affinityMask = data::Config::MINING_CPU_AFFINITY;
+    miningOptions.checkpointInterval = data::Config::MINING_CHECKPOINT_INTERVAL;
+    miningOptions.progressInterval = data::Config::MINING_PROGRESS_INTERVAL;
+    blockchain::mining::MiningEngine::setDefaultOptions(miningOptions);
 }
 
 void Application::initDependencies() {
+    initMiningOptions();
+
+    /**
+     * @brief The local mining pool the worker processes on this host attach to, if this process coordinates one.
+     * Registered before the mining service, so the queued jobs are drained before the pool goes away on exit.
+     */
+    if (coordinatesMiningPool) {
+        try {
+            setMiningPool(new blockchain::mining::MiningPool(data::Config::MINING_POOL_NAME, data::Config::MINING_POOL_RANGE_SIZE));
+            blockchain::mining::MiningPool::setCoordinator(miningPool);
+            std::atexit([]{ delete miningPool; });
+            std::cout << "Coordinating the mining pool " << data::Config::MINING_POOL_NAME << ", start workers with --pool-worker." << std::endl << std::endl;
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << " Mining without the pool." << std::endl << std::endl;
+        }
+    }
+
+    /**
+     * @brief The background queue every block is mined on, so the menu stays responsive.
+     * Queued blocks are still mined and recorded when the participant exits the program.
+     */
+    setMiningService(new blockchain::mining::MiningService());
+    std::atexit([]{ miningService->shutdown(); });
+
+    /**
+     * @brief The sidecar file the progress of the queued blocks is checkpointed to, so a killed process resumes it.
+     */
+    setMiningCheckpoint(new blockchain::mining::MiningCheckpoint(data::Config::MINING_CHECKPOINT_FILE_PATH));
+
+    /**
+     * @brief The schedule the mining target of every block type is adjusted on.
+     */
+    blockchain::mining::RetargetOptions retargetOptions;
+    retargetOptions.interval = data::Config::RETARGET_INTERVAL;
+    retargetOptions.targetMiningTime = data::Config::TARGET_MINING_TIME;
+
+    /**
+     * @brief The record format of the blockchain file, a file still in the other format is converted first.
+     */
+    const auto chainFormat = filesystem::ChainStore::parseFormat(data::Config::RECORDS_BLOCKCHAIN_FORMAT);
+    if (filesystem::ChainStore::migrate(data::Config::RECORDS_BLOCKCHAIN_FILE_PATH, chainFormat)) {
+        std::cout << "Converted the blockchain file to the " << data::Config::RECORDS_BLOCKCHAIN_FORMAT << " format." << std::endl << std::endl;
+    }
+
     /**
      * @brief The chain of blocks where all blocks are from the real data blockchain record.
      */
-    setBlockchain(new blockchain::Chain(data::Config::RECORDS_BLOCKCHAIN_FILE_PATH, data::Config::VERSION));
+    setBlockchain(new blockchain::Chain(data::Config::RECORDS_BLOCKCHAIN_FILE_PATH, data::Config::VERSION, data::Config::BITS, retargetOptions, chainFormat));
 
     /**
      * @brief The chain of blocks where some blocks are hidden (redacted) from the display view output to the currentParticipant.
      * aka. The temporary storage of the blockchain data.
      */
-    setRedactedBlockchain(new blockchain::Chain(data::Config::RECORDS_BLOCKCHAIN_FILE_PATH, data::Config::VERSION));
+    setRedactedBlockchain(new blockchain::Chain(data::Config::RECORDS_BLOCKCHAIN_FILE_PATH, data::Config::VERSION, data::Config::BITS, retargetOptions, chainFormat));
 
     /**
      * @brief The list of blocks in the blockchain network.
@@ -61,25 +151,49 @@ void Application::initializeBlockchain() {
     if (!blocks.empty()) {
         // Iterate over each BlockData and add the corresponding block to the blockchain
         for (const auto& blockData : blocks) {
+            // Blocks recorded before retargeting carry no bits of their own
+            const std::string bits = blockData.bits.empty() ? blockchain->getBits() : blockData.bits;
+            // Blocks keep the version they were hashed with, it decides how their merkle root is built
+            const int version = blockData.version > 0 ? blockData.version : data::Config::VERSION;
+            std::shared_ptr<blockchain::Block> block;
+
             if (blockData.type == blockchain::enums::BlockType::SUPPLIER) {
-                // Create a SupplierBlock from BlockData and add it to the blockchain
-                auto block = std::make_shared<blockchain::SupplierBlock>(conversion::DataConverter::convertToSupplierBlock(data::Config::VERSION, blockchain->getBits(), blockData.height, blockData.nonce, blockData.currentHash, blockData.previousHash, blockData.information, blockData.visible));
-                blockchain->addBlock(block);
-                redactedBlockchain->addBlock(block);
+                // Create a SupplierBlock from BlockData
+                block = std::make_shared<blockchain::SupplierBlock>(conversion::DataConverter::convertToSupplierBlock(version, bits, blockData.height, blockData.nonce, blockData.currentHash, blockData.previousHash, blockData.information, blockData.visible));
             } else if (blockData.type == blockchain::enums::BlockType::TRANSPORTER) {
-                // Create a TransporterBlock from BlockData and add it to the blockchain
-                auto block = std::make_shared<blockchain::TransporterBlock>(conversion::DataConverter::convertToTransporterBlock(data::Config::VERSION, blockchain->getBits(), blockData.height, blockData.nonce, blockData.currentHash, blockData.previousHash, blockData.information, blockData.visible));
-                blockchain->addBlock(block);
-                redactedBlockchain->addBlock(block);
+                // Create a TransporterBlock from BlockData
+                block = std::make_shared<blockchain::TransporterBlock>(conversion::DataConverter::convertToTransporterBlock(version, bits, blockData.height, blockData.nonce, blockData.currentHash, blockData.previousHash, blockData.information, blockData.visible));
             } else if (blockData.type == blockchain::enums::BlockType::TRANSACTION) {
-                // Create a TransactionBlock from BlockData and add it to the blockchain
-                auto block = std::make_shared<blockchain::TransactionBlock>(conversion::DataConverter::convertToTransactionBlock(data::Config::VERSION, blockchain->getBits(), blockData.height, blockData.nonce, blockData.currentHash, blockData.previousHash, blockData.information, blockData.visible));
+                // Create a TransactionBlock from BlockData
+                block = std::make_shared<blockchain::TransactionBlock>(conversion::DataConverter::convertToTransactionBlock(version, bits, blockData.height, blockData.nonce, blockData.currentHash, blockData.previousHash, blockData.information, blockData.visible));
+            }
+
+            if (block) {
+                // The recorded mining time feeds the retargeting of the blocks that follow
+                block->getHeader().setMiningTime(blockData.miningTime);
+
+                // The header is rebuilt as it was hashed, so the chain can be verified against its stored hashes
+                if (!blockData.timestamp.empty()) {
+                    block->getHeader().setTimestamp(static_cast<time_t>(std::stoll(blockData.timestamp)));
+                }
+                if (!blockData.merkleRoot.empty()) {
+                    block->getHeader().setMerkleRoot(blockData.merkleRoot);
+                }
                 blockchain->addBlock(block);
                 redactedBlockchain->addBlock(block);
             }
 
             setLastBlockType(blockData.type);
         }
+
+        if (!blockchain->verifyTargets()) {
+            std::cerr << "Warning: some blocks do not meet the mining target the chain assigns them." << std::endl;
+        }
+
+        const auto report = blockchain->verify(data::Config::VERIFY_THREADS);
+        if (!report.isValid()) {
+            std::cerr << "Warning: " << report.faults.size() << " of " << report.blockCount << " blocks fail verification, the first at height " << *report.getFirstFailingHeight() << "." << std::endl;
+        }
     }
 }
 
@@ -111,37 +225,228 @@ void Application::authenticateUser() {
     std::cout << "Welcome back, " << currentParticipant->getFullName() << "!" << std::endl << std::endl;
 }
 
+void Application::submitBlock(blockchain::enums::BlockType type, const std::string& information, const std::function<std::shared_ptr<blockchain::Block>(const std::string&, int, const std::string&)>& createBlock, uint64_t checkpointKey) {
+    std::string description = blockchain::enums::BlockTypeUtils::toString(type) + " block";
+
+    // The job stays in the checkpoint file until its block is recorded or it is cancelled
+    if (checkpointKey == 0) {
+        checkpointKey = miningCheckpoint->add(type, information);
+    }
+
+    // The records of a block that is not mined go back to the pool, they left it when the block was sealed
+    auto returnRecords = [type, information, description, checkpointKey] {
+        recordPool->restore(type, blockchain::hashing::MerkleTree::splitRecords(information));
+        miningCheckpoint->remove(checkpointKey);
+        std::cout << description << " was not mined, its records are back in the pool." << std::endl << std::endl;
+    };
+
+    auto handle = miningService->submit(description, blockchain::enums::MiningPriority::NORMAL, [type, information, createBlock, description, checkpointKey, returnRecords]{
+        blockchain::mining::MiningCheckpoint::setCurrent(miningCheckpoint, checkpointKey);
+        bool recorded = false;
+        bool failed = false;
+
+        try {
+            // Another job may extend the chain while this one mines, so mine again on top of the new tip until the block fits
+            while (true) {
+                // Constructing the block mines it
+                auto block = createBlock(blockchain->getNextBits(type), blockchain->getNextBlockHeight(), blockchain->getLastBlockHash());
+                if (blockchain::mining::MiningEngine::isCancelled() || !block->getHeader().isMined()) {
+                    break;
+                }
+
+                if (blockchain->commitBlock(block)) {
+                    redactedBlockchain->addBlock(block);
+                    std::cout << description << " at height " << block->getHeight() << " mined and recorded." << std::endl;
+                    recorded = true;
+                    break;
+                }
+            }
+        } catch (const std::exception& e) {
+            // Resumed, the job would fail the same way every session, so it is dropped and its information printed instead.
+            // Records sealed from the pool are no longer pending, this is the last place they are shown.
+            std::cerr << description << " failed to be mined: " << e.what() << " Its information was not recorded: " << information << std::endl << std::endl;
+            failed = true;
+        }
+
+        blockchain::mining::MiningCheckpoint::setCurrent(nullptr, 0);
+        if (recorded || failed) {
+            miningCheckpoint->remove(checkpointKey);
+        } else {
+            returnRecords(); // Cancelled, or out of nonces
+        }
+        return recorded;
+    }, returnRecords); // A job cancelled before it starts never runs, so it returns its records here instead
+
+    std::cout << description << " queued for mining as job " << handle.id << "." << std::endl << std::endl;
+}
+
+std::function<std::shared_ptr<blockchain::Block>(const std::string&, int, const std::string&)> Application::blockFactory(blockchain::enums::BlockType type, const std::string& information) {
+    return [type, information](const std::string& bits, int height, const std::string& previousHash) -> std::shared_ptr<blockchain::Block> {
+        if (type == blockchain::enums::BlockType::SUPPLIER) {
+            return std::make_shared<blockchain::SupplierBlock>(conversion::DataConverter::convertToSupplierBlock(data::Config::VERSION, bits, height, 0, "", previousHash, information, true));
+        } else if (type == blockchain::enums::BlockType::TRANSPORTER) {
+            return std::make_shared<blockchain::TransporterBlock>(conversion::DataConverter::convertToTransporterBlock(data::Config::VERSION, bits, height, 0, "", previousHash, information, true));
+        }
+        return std::make_shared<blockchain::TransactionBlock>(conversion::DataConverter::convertToTransactionBlock(data::Config::VERSION, bits, height, 0, "", previousHash, information, true));
+    };
+}
+
+void Application::resumeMiningJobs() {
+    for (const auto& record : miningCheckpoint->getRecords()) {
+        std::cout << "Resuming the pending " << blockchain::enums::BlockTypeUtils::toString(record.type) << " block of the last session." << std::endl;
+
+        // The block is rebuilt from its information exactly like the blocks loaded from the chain file
+        submitBlock(record.type, record.information, blockFactory(record.type, record.information), record.key);
+    }
+}
+
+void Application::initRecordPool() {
+    /**
+     * @brief The pool new records wait in, so a block is mined and written once per batch instead of once per record.
+     * The pending records stay in the sidecar file on exit and are sealed in the next session.
+     */
+    blockchain::pool::RecordPoolOptions poolOptions;
+    poolOptions.maxRecords = data::Config::RECORD_POOL_MAX_RECORDS;
+    poolOptions.maxAge = std::chrono::seconds(data::Config::RECORD_POOL_MAX_AGE);
+
+    setRecordPool(new blockchain::pool::RecordPool(data::Config::RECORD_POOL_FILE_PATH, poolOptions, [](blockchain::enums::BlockType type, const std::vector<std::string>& records) {
+        const std::string information = blockchain::Block::joinRecords(records);
+        std::cout << "Sealing " << records.size() << " " << blockchain::enums::BlockTypeUtils::toString(type) << " record" << (records.size() == 1 ? "" : "s") << " into a block." << std::endl;
+        submitBlock(type, information, blockFactory(type, information));
+    }, [](blockchain::enums::BlockType type, const std::vector<std::string>& records) {
+        // A batch the last session sealed reached its mining job if the checkpoint file holds the job
+        const std::string information = blockchain::Block::joinRecords(records);
+        const auto jobs = miningCheckpoint->getRecords();
+        return std::any_of(jobs.begin(), jobs.end(), [type, &information](const blockchain::mining::CheckpointRecord& job) {
+            return job.type == type && job.information == information;
+        });
+    }));
+    std::atexit([]{ recordPool->stop(); });
+
+    for (auto type : { blockchain::enums::BlockType::SUPPLIER, blockchain::enums::BlockType::TRANSPORTER, blockchain::enums::BlockType::TRANSACTION }) {
+        const size_t pending = recordPool->getPending(type).size();
+        if (pending > 0) {
+            std::cout << pending << " " << blockchain::enums::BlockTypeUtils::toString(type) << " record" << (pending == 1 ? " is" : "s are") << " pending from the last session." << std::endl;
+        }
+    }
+}
+
+void Application::poolRecord(blockchain::enums::BlockType type, const std::string& information) {
+    const size_t pending = recordPool->add(type, information);
+    if (pending > 0) {
+        std::cout << blockchain::enums::BlockTypeUtils::toString(type) << " record pooled, " << pending << " of " << data::Config::RECORD_POOL_MAX_RECORDS << " pending before the block is sealed." << std::endl << std::endl;
+    }
+}
+
+void Application::sealPendingRecords() {
+    if (recordPool->sealAll() == 0) {
+        std::cout << "No records are pending." << std::endl << std::endl;
+    }
+}
+
+std::vector<int> Application::getPendingRecordIds(blockchain::enums::BlockType type) {
+    std::vector<int> ids;
+    for (const auto& record : recordPool->getPending(type)) {
+        for (int id : filesystem::FileReader::extractRecordIds(record.information)) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+void Application::manageMiningJobs() {
+    auto jobs = miningService->getJobs();
+    if (jobs.empty()) {
+        std::cout << "No mining jobs are queued or running." << std::endl << std::endl;
+        return;
+    }
+
+    for (const auto& job : jobs) {
+        std::cout << "Job " << job.id << ": " << job.description
+                  << " (" << blockchain::enums::MiningPriorityUtils::toString(job.priority) << " priority, "
+                  << (job.running ? "running" : "queued") << ")" << std::endl;
+    }
+    std::cout << std::endl;
+
+    int id = collection::validation::InputValidator::validateInt("the id of the job to cancel, or 0 to keep them all");
+    if (id <= 0) {
+        return;
+    }
+
+    if (miningService->cancel(id)) {
+        std::cout << "Job " << id << " cancelled." << std::endl << std::endl;
+    } else {
+        std::cout << "Job " << id << " is not queued or running." << std::endl << std::endl;
+    }
+}
+
+void Application::verifyBlockchain() {
+    auto start = std::chrono::steady_clock::now();
+    const auto report = blockchain->verify(data::Config::VERIFY_THREADS);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (report.isValid()) {
+        std::cout << "All " << report.blockCount << " blocks verified in " << elapsed << " ms." << std::endl << std::endl;
+        return;
+    }
+
+    std::cout << report.faults.size() << " of " << report.blockCount << " blocks failed verification in " << elapsed << " ms, the first at height " << *report.getFirstFailingHeight() << "." << std::endl;
+    for (const auto& fault : report.faults) {
+        std::cout << "Height " << fault.height << ":"
+                  << (fault.hash ? " current hash does not match the header;" : "")
+                  << (fault.previousHash ? " previous hash does not link to the block before;" : "")
+                  << (fault.merkleRoot ? " merkle root does not match the information;" : "") << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void Application::proveBlockInclusion() {
+    int height = collection::validation::InputValidator::validateInt("the height of the block to prove");
+
+    blockchain::BlockInclusionProof inclusion;
+    try {
+        inclusion = blockchain->proveInclusion(height);
+    } catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl << std::endl;
+        return;
+    }
+
+    std::cout << "Chain root --> " << inclusion.root << " (" << inclusion.size << " blocks)" << std::endl
+              << "Block hash --> " << inclusion.blockHash << " (position " << inclusion.proof.leafIndex << ")" << std::endl;
+    for (const auto& step : inclusion.proof.steps) {
+        std::cout << (step.siblingOnLeft ? "Left sibling --> " : "Right sibling --> ") << step.sibling << std::endl;
+    }
+
+    bool verified = blockchain::hashing::MerkleMountainRange::verifyInclusion(inclusion.blockHash, inclusion.proof.leafIndex, inclusion.size, inclusion.proof, inclusion.root);
+    std::cout << (verified ? "The proof verifies against the chain root." : "The proof does not verify against the chain root.") << std::endl << std::endl;
+}
+
 void Application::displayMenu() {
     // Function vector to cycle through, using the InputCollector class for data collection
+    // The information is collected up front and pooled, the block it is sealed into is mined in the background
     std::vector<std::function<void()>> functions = {
             [&]{
                 // Collect information for Supplier block
                 auto info = collection::InputCollector::collectSupplierInfo(data::Config::OPTIONS_SUPPLIER_FILE_PATH);
-                // Create a SupplierBlock and add it to the blockchain
-                auto block = std::make_shared<blockchain::SupplierBlock>(data::Config::VERSION, blockchain->getBits(), blockchain->getNextBlockHeight(), blockchain->getLastBlockHash(), info);
-                blockchain->addBlock(block).addToRecord();
-                redactedBlockchain->addBlock(block);
+                // Pool the record until enough Supplier records are pending to seal a block
+                poolRecord(blockchain::enums::BlockType::SUPPLIER, info.toString());
             },
             [&]{
                 // Collect information for Transporter block
                 auto info = collection::InputCollector::collectTransporterInfo(data::Config::OPTIONS_TRANSPORTER_FILE_PATH);
-                // Create a TransporterBlock and add it to the blockchain
-                auto block = std::make_shared<blockchain::TransporterBlock>(data::Config::VERSION, blockchain->getBits(), blockchain->getNextBlockHeight(), blockchain->getLastBlockHash(), info);
-                blockchain->addBlock(block).addToRecord();
-                redactedBlockchain->addBlock(block);
+                // Pool the record until enough Transporter records are pending to seal a block
+                poolRecord(blockchain::enums::BlockType::TRANSPORTER, info.toString());
             },
             [&]{
                 // Collect information for Transaction block
-                auto info = collection::InputCollector::collectTransactionInfo(data::Config::OPTIONS_TRANSACTION_FILE_PATH, data::Config::RECORDS_BLOCKCHAIN_FILE_PATH);
-                // Create a TransactionBlock and add it to the blockchain
-                auto block = std::make_shared<blockchain::TransactionBlock>(data::Config::VERSION, blockchain->getBits(), blockchain->getNextBlockHeight(), blockchain->getLastBlockHash(), info);
-                blockchain->addBlock(block).addToRecord();
-                redactedBlockchain->addBlock(block);
+                auto info = collection::InputCollector::collectTransactionInfo(data::Config::OPTIONS_TRANSACTION_FILE_PATH, data::Config::RECORDS_BLOCKCHAIN_FILE_PATH, getPendingRecordIds(blockchain::enums::BlockType::TRANSACTION));
+                // Pool the record until enough Transaction records are pending to seal a block
+                poolRecord(blockchain::enums::BlockType::TRANSACTION, info.toString());
             }
     };
 
     // Define options for user actions and block search criteria
-    std::vector<std::string> actionOptions = { "Display blockchain", "Search Block", "Add Block", "Manipulate Block" };
+    std::vector<std::string> actionOptions = { "Display blockchain", "Search Block", "Add Block", "Manipulate Block", "Mining Jobs", "Verify Blockchain", "Seal Pending Records", "Prove Block Inclusion" };
     std::vector<std::string> searchOptions = { "Block Type", "Height", "Version", "Nonce", "Current Hash", "Previous Hash", "Merkle Root", "Timestamp", "Bits", "Information" };
 
     // Determine the index for selecting the next type of block to add
@@ -200,7 +505,23 @@ void Application::displayMenu() {
                 break;
             case 4:
                 // Manipulate block
-                collection::InputCollector::collectBlockManipulationCriteria(*blockchain, *redactedBlockchain, searchOptions);
+                collection::InputCollector::collectBlockManipulationCriteria(*blockchain, *redactedBlockchain, *miningService, searchOptions);
+                break;
+            case 5:
+                // List and cancel the background mining jobs
+                manageMiningJobs();
+                break;
+            case 6:
+                // Check the stored hashes, links and merkle roots of every block
+                verifyBlockchain();
+                break;
+            case 7:
+                // Seal the pooled records into blocks without waiting for the batch to fill
+                sealPendingRecords();
+                break;
+            case 8:
+                // Prove a block is part of the chain against the root of the merkle mountain range
+                proveBlockInclusion();
                 break;
         }
     } while (true);
@@ -217,6 +538,10 @@ void Application::run() {
 // getters
 blockchain::Chain* Application::getBlockchain() { return blockchain; }
 blockchain::Chain* Application::getRedactedBlockchain() { return redactedBlockchain; }
+blockchain::mining::MiningService* Application::getMiningService() { return miningService; }
+blockchain::mining::MiningPool* Application::getMiningPool() { return miningPool; }
+blockchain::mining::MiningCheckpoint* Application::getMiningCheckpoint() { return miningCheckpoint; }
+blockchain::pool::RecordPool* Application::getRecordPool() { return recordPool; }
 std::vector<authentication::Participant>& Application::getParticipants() { return participants; }
 authentication::Participant* Application::getCurrentParticipant() { return currentParticipant.get(); }
 std::vector<filesystem::BlockData>& Application::getBlocks() { return blocks; }
@@ -225,6 +550,11 @@ blockchain::enums::BlockType Application::getLastBlockType() { return lastBlockT
 // setters
 void Application::setBlockchain(blockchain::Chain* chain) { blockchain = chain; }
 void Application::setRedactedBlockchain(blockchain::Chain* chain) { redactedBlockchain = chain; }
+void Application::setMiningService(blockchain::mining::MiningService* service) { miningService = service; }
+void Application::setMiningPool(blockchain::mining::MiningPool* pool) { miningPool = pool; }
+void Application::setMiningCheckpoint(blockchain::mining::MiningCheckpoint* checkpoint) { miningCheckpoint = checkpoint; }
+void Application::setRecordPool(blockchain::pool::RecordPool* pool) { recordPool = pool; }
+void Application::setCoordinatesMiningPool(bool coordinates) { coordinatesMiningPool = coordinates; }
 void Application::setParticipants(const std::vector<authentication::Participant>& participants) { Application::participants = participants; }
 void Application::setCurrentParticipant(std::unique_ptr<authentication::Participant> user) { currentParticipant = std::move(user); }
 void Application::setBlocks(const std::vector<filesystem::BlockData>& blocks) { Application::blocks = blocks; }
@@ -2,6 +2,10 @@
 #define APPLICATION_H
 
 #include "blockchain/Chain.h"
+#include "blockchain/mining/MiningCheckpoint.h"
+#include "blockchain/mining/MiningPool.h"
+#include "blockchain/mining/MiningService.h"
+#include "blockchain/pool/RecordPool.h"
 #include "authentication/Participant.h"
 #include "filesystem/FileReader.h"
 
@@ -20,6 +24,21 @@ public:
      */
     static void run();
 
+    /**
+     * @brief Runs the process as a worker of the local mining pool instead of the application.
+     * @return The exit code of the process.
+     */
+    static int runMiningPoolWorker();
+
+    /**
+     * @brief Converts a blockchain file to the text or binary record format, one block at a time.
+     * @param sourcePath Blockchain file in either format.
+     * @param targetPath File the converted blocks are written to, overwritten.
+     * @param format "text" or "binary".
+     * @return The exit code of the process.
+     */
+    static int convertChainFile(const std::string& sourcePath, const std::string& targetPath, const std::string& format);
+
     /**
      * @brief Sets the blockchain instance.
      * @param blockchain Pointer to the blockchain.
@@ -32,6 +51,36 @@ public:
      */
     static void setRedactedBlockchain(blockchain::Chain* redactedBlockchain);
 
+    /**
+     * @brief Sets the mining service instance.
+     * @param miningService Pointer to the mining service.
+     */
+    static void setMiningService(blockchain::mining::MiningService* miningService);
+
+    /**
+     * @brief Sets the mining pool instance.
+     * @param miningPool Pointer to the mining pool.
+     */
+    static void setMiningPool(blockchain::mining::MiningPool* miningPool);
+
+    /**
+     * @brief Sets the mining checkpoint instance.
+     * @param miningCheckpoint Pointer to the mining checkpoint.
+     */
+    static void setMiningCheckpoint(blockchain::mining::MiningCheckpoint* miningCheckpoint);
+
+    /**
+     * @brief Sets the pending record pool instance.
+     * @param recordPool Pointer to the record pool.
+     */
+    static void setRecordPool(blockchain::pool::RecordPool* recordPool);
+
+    /**
+     * @brief Sets whether the application coordinates a local mining pool.
+     * @param coordinates Whether new blocks are mined together with the worker processes.
+     */
+    static void setCoordinatesMiningPool(bool coordinates);
+
     /**
      * @brief Sets the list of participants.
      * @param participants List of participants.
@@ -66,6 +115,26 @@ public:
      */
     static blockchain::Chain* getRedactedBlockchain();
 
+    /**
+     * @brief Gets the mining service instance.
+     */
+    static blockchain::mining::MiningService* getMiningService();
+
+    /**
+     * @brief Gets the mining pool instance, null if the application does not coordinate one.
+     */
+    static blockchain::mining::MiningPool* getMiningPool();
+
+    /**
+     * @brief Gets the mining checkpoint instance.
+     */
+    static blockchain::mining::MiningCheckpoint* getMiningCheckpoint();
+
+    /**
+     * @brief Gets the pending record pool instance.
+     */
+    static blockchain::pool::RecordPool* getRecordPool();
+
     /**
      * @brief Gets the list of participants.
      */
@@ -89,6 +158,11 @@ public:
 private:
     static blockchain::Chain* blockchain; /**< Pointer to the blockchain instance. */
     static blockchain::Chain* redactedBlockchain; /**< Pointer to the redacted blockchain instance. */
+    static blockchain::mining::MiningService* miningService; /**< Pointer to the background mining service. */
+    static blockchain::mining::MiningPool* miningPool; /**< Pointer to the coordinated mining pool, if any. */
+    static blockchain::mining::MiningCheckpoint* miningCheckpoint; /**< Pointer to the checkpoint of the pending mining jobs. */
+    static blockchain::pool::RecordPool* recordPool; /**< Pointer to the pool of the records waiting to be sealed into a block. */
+    static bool coordinatesMiningPool; /**< Whether the application coordinates a local mining pool. */
     static std::vector<authentication::Participant> participants; /**< List of participants. */
     static std::unique_ptr<authentication::Participant> currentParticipant; /**< Pointer to the current participant. */
     static std::vector<filesystem::BlockData> blocks; /**< List of block data. */
@@ -109,10 +183,77 @@ private:
      */
     static void displayMenu();
 
+    /**
+     * @brief Queues a new block to be mined in the background and recorded on top of the chain.
+     * @param type Type of the block.
+     * @param information Information of the block, recorded in the checkpoint file until the block is recorded.
+     * @param createBlock Creates (and so mines) the block from its bits, height and previous hash.
+     * @param checkpointKey Key of the checkpoint of a resumed job, 0 for a new one.
+     */
+    static void submitBlock(blockchain::enums::BlockType type, const std::string& information, const std::function<std::shared_ptr<blockchain::Block>(const std::string&, int, const std::string&)>& createBlock, uint64_t checkpointKey = 0);
+
+    /**
+     * @brief Gets the factory of a block rebuilt from its information string, the way blocks are loaded from the chain file.
+     * @param type Type of the block.
+     * @param information Information of the block, one or more records.
+     * @return Creates (and so mines) the block from its bits, height and previous hash.
+     */
+    static std::function<std::shared_ptr<blockchain::Block>(const std::string&, int, const std::string&)> blockFactory(blockchain::enums::BlockType type, const std::string& information);
+
+    /**
+     * @brief Queues the blocks that were still being mined when the last session ended.
+     */
+    static void resumeMiningJobs();
+
+    /**
+     * @brief Starts the pool new records wait in until they are sealed into a block.
+     * Started last, since the records left by the last session may be due and get sealed right away.
+     */
+    static void initRecordPool();
+
+    /**
+     * @brief Adds a new record to the pool of its block type.
+     * @param type Type of the block the record goes into.
+     * @param information Information of the record.
+     */
+    static void poolRecord(blockchain::enums::BlockType type, const std::string& information);
+
+    /**
+     * @brief Seals every pending record into blocks without waiting for the thresholds.
+     */
+    static void sealPendingRecords();
+
+    /**
+     * @brief Gets the IDs of the pending records of a block type, which are not in the chain file yet.
+     * @param type Type of the block.
+     * @return
+     */
+    static std::vector<int> getPendingRecordIds(blockchain::enums::BlockType type);
+
+    /**
+     * @brief Lists the background mining jobs and lets the participant cancel one.
+     */
+    static void manageMiningJobs();
+
+    /**
+     * @brief Verifies every block of the blockchain and reports the failing heights.
+     */
+    static void verifyBlockchain();
+
+    /**
+     * @brief Prints the proof that a block is part of the blockchain, checked against the root of its merkle mountain range.
+     */
+    static void proveBlockInclusion();
+
     /**
      * @brief Initializes dependencies required by the application.
      */
     static void initDependencies();
+
+    /**
+     * @brief Initializes the options every block is mined with.
+     */
+    static void initMiningOptions();
 };
 
 #endif // APPLICATION_H
@@ -2,14 +2,14 @@
 #include "Block.h"
 
 namespace blockchain {
-    Block::Block(const int version, const std::string bits, int height, const std::string& previousHash, const std::string& information, blockchain::enums::BlockType type, int nonce, const std::string& currentHash, bool visible)
+    Block::Block(const int version, const std::string bits, int height, const std::string& previousHash, const std::string& information, blockchain::enums::BlockType type, uint32_t nonce, const std::string& currentHash, bool visible)
             : height(height), type(type), header(type, version, bits, information, nonce, currentHash, previousHash), visible(visible) {
     }
 
     // Getter methods
     blockchain::enums::BlockType Block::getType() const { return type; }
     int Block::getHeight() const { return height; }
-    int Block::getNonce() const { return header.getNonce(); }
+    uint32_t Block::getNonce() const { return header.getNonce(); }
     BlockHeader& Block::getHeader() { return header; }
     BlockHeader Block::getHeader() const { return header; }
     bool Block::isGenesis() const { return genesis; }
@@ -19,4 +19,12 @@ namespace blockchain {
     void Block::setGenesis(bool genesisValue) { genesis = genesisValue; }
     void Block::setVisible(bool visibility) { visible = visibility; }
     void Block::setInformationString(const std::string& information) { header.setInformationString(information); }
+
+    std::string Block::joinRecords(const std::vector<std::string>& records) {
+        std::string information;
+        for (size_t i = 0; i < records.size(); ++i) {
+            information += (i > 0 ? hashing::MerkleTree::RECORD_SEPARATOR : "") + records[i];
+        }
+        return information;
+    }
 } // namespace blockchain
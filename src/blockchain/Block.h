@@ -7,6 +7,7 @@
 #include <sstream>
 #include <iomanip>
 #include <memory>
+#include <vector>
 #include "BlockHeader.h"
 #include "enums/BlockType.h"
 
@@ -42,7 +43,7 @@ namespace blockchain {
          *
          * @return
          */
-        [[nodiscard]] int getNonce() const;
+        [[nodiscard]] uint32_t getNonce() const;
 
         /**
          * @brief Get the header of the block.
@@ -95,6 +96,31 @@ namespace blockchain {
          */
         void setInformationString(const std::string& information);
 
+        /**
+         * @brief Join the records of a block into its information string
+         *
+         * @param records
+         * @return
+         */
+        static std::string joinRecords(const std::vector<std::string>& records);
+
+        /**
+         * @brief Join the records of a block into its information string
+         *
+         * @tparam Info A BlockInfo type
+         * @param records
+         * @return
+         */
+        template <typename Info>
+        static std::string joinRecords(const std::vector<Info>& records) {
+            std::vector<std::string> strings;
+            strings.reserve(records.size());
+            for (const auto& record : records) {
+                strings.push_back(record.toString());
+            }
+            return joinRecords(strings);
+        }
+
         /**
          * @brief Creates a deep copy of the current block's instance
          *
@@ -141,6 +167,6 @@ namespace blockchain {
          * @param currentHash
          * @param visible
          */
-        Block(const int version, const std::string bits, int height, const std::string& previousHash, const std::string& information, blockchain::enums::BlockType type, int nonce = 0, const std::string& currentHash = "", bool visible = true);
+        Block(const int version, const std::string bits, int height, const std::string& previousHash, const std::string& information, blockchain::enums::BlockType type, uint32_t nonce = 0, const std::string& currentHash = "", bool visible = true);
     };
 } // namespace blockchain
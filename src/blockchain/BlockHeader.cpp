@@ -1,93 +1,66 @@
 #include "BlockHeader.h"
 #include "../utils/Datetime.h"
-#include "../../libs/sha256/sha256.h"
-#include "../../libs/sha384/sha384.h"
-#include "../../libs/sha512/sha512.h"
-#include <random>
+#include "mining/MiningCheckpoint.h"
+#include "mining/MiningEngine.h"
+#include "mining/MiningPool.h"
+#include "mining/MiningTraits.h"
+#include "mining/NonceSearch.h"
+#include "mining/ProgressReporter.h"
+#include "mining/Target.h"
+#include <cstring>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 namespace blockchain {
     /**
-     * @brief Convert a hexadecimal string to a byte array
+     * @brief Write a 32-bit value into the block header buffer in little-endian order
      * Helper method
      *
-     * @param hex
-     * @return
-     */
-    std::vector<uint8_t> hexStringToBytes(const std::string& hex) {
-        std::vector<uint8_t> bytes;
-
-        for (size_t i = 0; i < hex.length(); i += 2) {
-            std::string byteString = hex.substr(i, 2);
-            uint8_t byte = static_cast<uint8_t>(strtol(byteString.c_str(), nullptr, 16));
-            bytes.push_back(byte);
-        }
-
-        return bytes;
-    }
-
-    /**
-     * @brief Append data to the block header vector for hashing
-     * Helper method
-     *
-     * @param vec
+     * @param buffer
      * @param value
+     * @return The number of bytes written
      */
-    void appendIntToVector(std::vector<uint8_t>& vec, uint32_t value) {
+    size_t writeIntToBuffer(uint8_t* buffer, uint32_t value) {
         for (int i = 0; i < 4; ++i) {
-            vec.push_back((value >> (i * 8)) & 0xFF);
+            buffer[i] = (value >> (i * 8)) & 0xFF;
         }
+        return 4;
     }
 
     /**
-     * @brief Append hexadecimal data to the block header vector for hashing
+     * @brief Write the bytes of a digest into the block header buffer
      * Helper method
      *
-     * @param vec
-     * @param hex
+     * @param buffer
+     * @param digest
+     * @return The number of bytes written
      */
-    void appendHexToVector(std::vector<uint8_t>& vec, const std::string& hex) {
-        // Ensure the hex string's length is even
-        if (hex.length() % 2 != 0) {
-            throw std::runtime_error("Invalid hexadecimal string.");
-        }
-
-        // Convert each pair of hexadecimal characters to a byte and append to the vector
-        for (size_t i = 0; i < hex.length(); i += 2) {
-            std::string byteString = hex.substr(i, 2);
-            char byte = static_cast<char>(std::stoul(byteString, nullptr, 16));
-            vec.push_back(static_cast<uint8_t>(byte));
-        }
+    size_t writeDigestToBuffer(uint8_t* buffer, const hashing::Digest& digest) {
+        std::memcpy(buffer, digest.data(), digest.size);
+        return digest.size;
     }
 
-    std::function<std::string(std::string)> BlockHeader::getHashFunction(blockchain::enums::BlockType type) {
-        switch (type) {
-            case blockchain::enums::BlockType::SUPPLIER:
-            default: // Default to SHA-256
-                return sha256;
-            case blockchain::enums::BlockType::TRANSPORTER:
-                return sha384;
-            case blockchain::enums::BlockType::TRANSACTION:
-                return sha512;
-        }
-    }
-
-    BlockHeader::BlockHeader(blockchain::enums::BlockType type, const int version, const std::string bits, const std::string& informationString, int nonce, const std::string& currentHash, const std::string& previousHash)
-            : type(type), version(version), bits(bits), informationString(informationString) {
+    BlockHeader::BlockHeader(blockchain::enums::BlockType type, const int version, const std::string bits, const std::string& informationString, uint32_t nonce, const std::string& currentHash, const std::string& previousHash)
+            : type(type), version(version), bits(bits), informationString(informationString), merkleTree(hashing::Hasher::forBlockType(type)) {
         // Initialize timestamp with the current date and time
         setTimestamp(std::time(nullptr)); // Current time
 
         // For a genesis block, set the previous block hash to initially 64 zeros
         setPrevHash(previousHash.empty() || previousHash == "0" ? std::string(64, '0') : previousHash);
-        setMerkleRoot(getHashFunction(type)(informationString));
+        updateMerkleRoot();
 
         if (currentHash.empty()) {
-            setHash(mine(getHashFunction(type)));
+            // The time to mine a new block drives the difficulty retargeting of the chain
+            auto start = std::chrono::steady_clock::now();
+            setHash(mine());
+            setMiningTime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
         } else {
-            setMined(true); // Block is already mined (from file data
             setHash(currentHash);
             setNonce(nonce);
+            setMined(meetsTarget()); // Block from file data is mined if its hash meets the target
         }
 
         // Set the previous hash to the mined hash for genesis block.
@@ -96,97 +69,323 @@ namespace blockchain {
         }
     }
 
-    std::string BlockHeader::mine(std::function<std::string(std::string)> hashFunction) {
-        // Target defined for a hash to start with "0000", so first 2 bytes should be zero
-        std::vector<uint8_t> targetPrefix = {0x00, 0x00};
+    hashing::Digest BlockHeader::mine() {
+        // The algorithm is fixed per block type, so the specialized loop is picked once per block
+        switch (hashing::Hasher::forBlockType(type).getAlgorithm()) {
+            case blockchain::enums::HashAlgorithm::SHA256:
+            default:
+                return mineWith<blockchain::enums::HashAlgorithm::SHA256>();
+            case blockchain::enums::HashAlgorithm::SHA384:
+                return mineWith<blockchain::enums::HashAlgorithm::SHA384>();
+            case blockchain::enums::HashAlgorithm::SHA512:
+                return mineWith<blockchain::enums::HashAlgorithm::SHA512>();
+        }
+    }
 
-        // The current hash is in hexadecimal
-        std::string currentHashHex;
+    hashing::Digest BlockHeader::mine(bool genesis) {
+        if (!genesis) {
+            return mine();
+        }
 
-        // Begin mining process
-        this->nonce = 0;
-        bool hashFound = false;
+        // The self-link of a genesis block is not part of what it is hashed over
+        const hashing::Digest link = previousHash;
+        setPrevHash(std::string(64, '0'));
+        hashing::Digest minedHash = mine();
+        setPrevHash(minedHash.empty() ? link : minedHash);
+        return minedHash;
+    }
 
-        do {
-            currentHashHex = generateHash(hashFunction);
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    hashing::Digest BlockHeader::mineWith() {
+        using Layout = mining::HeaderLayout<Algorithm>;
 
-            // Convert the current hash back to bytes for comparison
-            std::vector<uint8_t> currentHashBytes = hexStringToBytes(currentHashHex);
+        // Everything but the trailing nonce stays the same between attempts, until the timestamp is rolled
+        uint8_t headerPrefix[Layout::MAX_SIZE];
+        size_t prefixLength = 0;
+        auto serializeTemplate = [&] {
+            prefixLength = serializeHeaderPrefix<Algorithm>(headerPrefix);
+            hashing::Digest templateDigest;
+            hashing::Hasher::forBlockType(type).hash(headerPrefix, prefixLength, templateDigest);
+            return templateDigest.toHex();
+        };
 
-            // Check if the first two bytes of the hash are zeros (i.e., check for "0000" prefix)
-            hashFound = std::equal(targetPrefix.begin(), targetPrefix.end(), currentHashBytes.begin());
+        // A job resumed after a restart mines with the timestamp of its checkpoint, and if that gives
+        // the same template again, the nonces the checkpoint covers are skipped
+        mining::MiningCheckpoint* checkpoint = mining::MiningCheckpoint::getCurrent();
+        std::optional<mining::CheckpointRecord> record;
+        if (checkpoint != nullptr) {
+            record = checkpoint->find(mining::MiningCheckpoint::getCurrentKey());
+        }
 
-            // If a valid hash is found or if we've reached the maximum nonce value, we stop
-            if (hashFound || nonce == std::numeric_limits<int>::max()) {
-                break;
+        std::string templateHash;
+        uint64_t begin = 0;
+        if (record && !record->templateHash.empty()) {
+            const time_t currentTimestamp = timestamp;
+            setTimestamp(record->timestamp);
+            templateHash = serializeTemplate();
+            if (templateHash == record->templateHash) {
+                begin = record->covered;
+                std::cout << "Resuming mining from nonce index " << begin << " of the checkpoint." << std::endl;
+            } else {
+                setTimestamp(currentTimestamp); // The chain moved on, the progress belongs to another template
+                templateHash.clear();
             }
+        }
+        if (templateHash.empty()) {
+            templateHash = serializeTemplate();
+        }
+
+        mining::MiningEngine::Checkpoint onCheckpoint;
+        if (record) {
+            record->templateHash = templateHash;
+            record->timestamp = static_cast<uint32_t>(timestamp);
+            record->covered = begin;
+            checkpoint->save(*record);
+            onCheckpoint = [checkpoint, &record](uint64_t covered) {
+                record->covered = covered;
+                checkpoint->save(*record);
+            };
+        }
+
+        const size_t timestampPosition = prefixLength - Layout::NONCE_OFFSET + Layout::TIMESTAMP_OFFSET;
+        const mining::Target target = mining::Target::fromBits(bits);
+        const mining::MiningOptions options = mining::MiningEngine::getDefaultOptions();
+
+        // The workers only count their attempts, the reporter prints them from its own thread
+        mining::ProgressReporter progress(std::chrono::milliseconds(options.progressInterval), target.getExpectedAttempts());
+
+        // Begin mining process, every 32-bit nonce of the current timestamp first, then of the rolled ones.
+        // The engine deals the whole index space to its workers, so no two workers ever hash the same header.
+        std::optional<uint64_t> foundIndex;
+        if (mining::MiningPool* pool = mining::MiningPool::getCoordinator()) {
+            // The worker processes of the pool share the index space with the threads of this one
+            foundIndex = pool->mine(Algorithm, headerPrefix, prefixLength, timestampPosition, static_cast<uint32_t>(timestamp), target, progress, begin);
+        } else {
+            const mining::RollingPrefix<Algorithm> prefix(headerPrefix, prefixLength, timestampPosition, static_cast<uint32_t>(timestamp));
+            mining::MiningEngine engine(options);
+            foundIndex = engine.search(begin, std::numeric_limits<uint64_t>::max(), mining::makeChunkSearch<Algorithm>(prefix, target, progress), onCheckpoint);
+        }
+        progress.stop();
 
-            // Increment the nonce for the next attempt
-            ++this->nonce;
-            std::cout << "Mining... Nonce: " << this->nonce << ", Hash: " << currentHashHex << "\r" << std::flush;
-        } while (!hashFound);
+        if (foundIndex) {
+            const uint32_t roll = static_cast<uint32_t>(*foundIndex >> 32);
+            this->nonce = static_cast<uint32_t>(*foundIndex);
+            if (roll > 0) {
+                setTimestamp(timestamp + roll);
+            }
 
-        if (hashFound) {
-            std::cout << std::endl << std::endl << "Block mined! Nonce: " << this->nonce << ", Hash: " << currentHashHex << std::endl << std::endl;
+            hashing::Digest currentHash = generateHash<Algorithm>();
+            std::cout << std::endl << std::endl << "Block mined! Nonce: " << this->nonce;
+            if (roll > 0) {
+                std::cout << ", Timestamp rolled by " << roll << "s";
+            }
+            std::cout << ", Hash: " << currentHash << std::endl << std::endl;
             setMined(true);
-            return currentHashHex;
+            return currentHash;
+        } else if (mining::MiningEngine::isCancelled()) {
+            std::cout << std::endl << std::endl << "Mining cancelled." << std::endl << std::endl;
+            return hashing::Digest();
         } else {
-            std::cout << std::endl << std::endl << "Mining ended, nonce limit reached." << std::endl << std::endl;
-            return "";
+            this->nonce = std::numeric_limits<uint32_t>::max();
+            std::cout << std::endl << std::endl << "Mining ended, nonce space exhausted." << std::endl << std::endl;
+            return hashing::Digest();
         }
     }
 
-    std::basic_string<char> BlockHeader::generateHash(const std::function<std::string(std::string)> &hashFunction) const {
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    size_t BlockHeader::serializeHeaderPrefix(uint8_t* buffer) const {
+        using Layout = mining::HeaderLayout<Algorithm>;
+
+        // The bits are parsed into a digest only for its fixed storage
+        const hashing::Digest bitsBytes = hashing::Digest::fromHex(bits);
+        if (bitsBytes.size != Layout::BITS_SIZE || merkleRoot.size != Layout::MERKLE_ROOT_SIZE) {
+            throw std::runtime_error("Invalid block header.");
+        }
+
         // Construct the block header as a byte array for hashing
-        std::vector<uint8_t> blockHeader;
+        writeIntToBuffer(buffer + Layout::VERSION_OFFSET, version);
+        const size_t prevHashSize = writeDigestToBuffer(buffer + Layout::PREVIOUS_HASH_OFFSET, previousHash);
 
-        appendIntToVector(blockHeader, version);
-        appendHexToVector(blockHeader, previousHash);
-        appendHexToVector(blockHeader, merkleRoot); // in hex value
+        uint8_t* fields = buffer + Layout::PREVIOUS_HASH_OFFSET + prevHashSize;
+        writeDigestToBuffer(fields + Layout::MERKLE_ROOT_OFFSET, merkleRoot);
         // Timestamp needs to be converted to bytes and appended
-        appendIntToVector(blockHeader, static_cast<uint32_t>(timestamp));
-        appendHexToVector(blockHeader, bits);
-        appendIntToVector(blockHeader, nonce);
+        writeIntToBuffer(fields + Layout::TIMESTAMP_OFFSET, static_cast<uint32_t>(timestamp));
+        writeDigestToBuffer(fields + Layout::BITS_OFFSET, bitsBytes);
+
+        return Layout::PREVIOUS_HASH_OFFSET + prevHashSize + Layout::NONCE_OFFSET;
+    }
 
-        // Convert blockHeader to a string for SHA256 hashing
-        std::string blockHeaderStr(blockHeader.begin(), blockHeader.end());
+    size_t BlockHeader::serialize(uint8_t* buffer) const {
+        switch (hashing::Hasher::forBlockType(type).getAlgorithm()) {
+            case blockchain::enums::HashAlgorithm::SHA256:
+            default:
+                return serialize<blockchain::enums::HashAlgorithm::SHA256>(buffer);
+            case blockchain::enums::HashAlgorithm::SHA384:
+                return serialize<blockchain::enums::HashAlgorithm::SHA384>(buffer);
+            case blockchain::enums::HashAlgorithm::SHA512:
+                return serialize<blockchain::enums::HashAlgorithm::SHA512>(buffer);
+        }
+    }
+
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    size_t BlockHeader::serialize(uint8_t* buffer) const {
+        // Append the nonce to the constant part of the header
+        const size_t length = serializeHeaderPrefix<Algorithm>(buffer);
+        return length + writeIntToBuffer(buffer + length, nonce);
+    }
+
+    hashing::Digest BlockHeader::generateHash() const {
+        switch (hashing::Hasher::forBlockType(type).getAlgorithm()) {
+            case blockchain::enums::HashAlgorithm::SHA256:
+            default:
+                return generateHash<blockchain::enums::HashAlgorithm::SHA256>();
+            case blockchain::enums::HashAlgorithm::SHA384:
+                return generateHash<blockchain::enums::HashAlgorithm::SHA384>();
+            case blockchain::enums::HashAlgorithm::SHA512:
+                return generateHash<blockchain::enums::HashAlgorithm::SHA512>();
+        }
+    }
+
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    hashing::Digest BlockHeader::generateHash() const {
+        using Context = typename mining::HashTraits<Algorithm>::Context;
+
+        uint8_t blockHeader[mining::HeaderLayout<Algorithm>::MAX_SIZE];
+        const size_t length = serialize<Algorithm>(blockHeader);
 
-        // Hash the block header using the provided hash function
-        return hashFunction(blockHeaderStr);
+        // Hash the block header with the algorithm of its block type
+        hashing::Digest digest;
+        Context ctx;
+        ctx.init();
+        ctx.update(blockHeader, length);
+        ctx.final(digest.bytes.data());
+        digest.size = mining::HashTraits<Algorithm>::DIGEST_SIZE;
+        return digest;
     }
 
     BlockHeader& BlockHeader::updateEditableData(const std::string informationString, const std::string& prevHash) {
         setInformationString(informationString);
-        setMerkleRoot(getHashFunction(type)(informationString));
+        updateMerkleRoot();
         setPrevHash(prevHash.empty() || prevHash == "0" ? std::string(64, '0') : prevHash);
-        setHash(generateHash(getHashFunction(type)));
+        setHash(generateHash());
         setMined(false); // Reset mined status after updating data, currentParticipant has the choice to mine again
-        setPrevHash(prevHash.empty() || prevHash == "0" ? hash : prevHash);
+        if (prevHash.empty() || prevHash == "0") {
+            setPrevHash(hash);
+        } else {
+            setPrevHash(prevHash);
+        }
 
         return *this;
     }
 
+    bool BlockHeader::meetsTarget() const {
+        return mining::Target::fromBits(bits).isMetBy(hash);
+    }
+
+    hashing::Digest BlockHeader::computeHash(bool genesis) const {
+        if (!genesis) {
+            return generateHash();
+        }
+
+        BlockHeader unlinked(*this);
+        unlinked.setPrevHash(std::string(64, '0'));
+        return unlinked.generateHash();
+    }
+
+    hashing::Digest BlockHeader::computeMerkleRoot() const {
+        const hashing::Hasher hasher = hashing::Hasher::forBlockType(type);
+        hashing::Digest digest;
+        if (!hasMerkleTree()) {
+            hasher.hash(informationString, digest);
+            return digest;
+        }
+
+        // The cached trees were built from the same fields unless the information was set around them
+        const std::vector<std::string> records = hashing::MerkleTree::splitRecords(informationString);
+        std::vector<hashing::Digest> roots;
+        roots.reserve(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            std::vector<std::string> fields = hashing::MerkleTree::splitFields(records[i]);
+            if (records.size() == recordTrees.size() && fields == recordTrees[i].getLeaves()) {
+                roots.push_back(recordTrees[i].getRoot());
+            } else {
+                roots.push_back(hashing::MerkleTree::computeRoot(hasher, fields));
+            }
+        }
+        return hashing::MerkleTree::computeRoot(hasher, std::move(roots));
+    }
+
+    bool BlockHeader::hasMerkleTree() const {
+        return version >= MERKLE_TREE_VERSION;
+    }
+
+    hashing::MerkleProof BlockHeader::proveField(size_t recordIndex, size_t fieldIndex) const {
+        if (!hasMerkleTree()) {
+            throw std::runtime_error("The merkle root of a version " + std::to_string(version) + " block has no fields to prove.");
+        }
+        if (recordIndex >= recordTrees.size()) {
+            throw std::out_of_range("Record index out of range.");
+        }
+
+        // The path within the record continues with the path of the record's root within the block
+        hashing::MerkleProof proof = recordTrees[recordIndex].prove(fieldIndex);
+        const hashing::MerkleProof recordProof = merkleTree.prove(recordIndex);
+        proof.steps.insert(proof.steps.end(), recordProof.steps.begin(), recordProof.steps.end());
+        return proof;
+    }
+
+    void BlockHeader::updateMerkleRoot() {
+        if (!hasMerkleTree()) {
+            hashing::Hasher::forBlockType(type).hash(informationString, merkleRoot);
+            return;
+        }
+
+        const hashing::Hasher hasher = hashing::Hasher::forBlockType(type);
+        const std::vector<std::string> records = hashing::MerkleTree::splitRecords(informationString);
+        recordTrees.resize(records.size(), hashing::MerkleTree(hasher));
+
+        std::vector<hashing::Digest> roots;
+        roots.reserve(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            recordTrees[i].assign(hashing::MerkleTree::splitFields(records[i]));
+            roots.push_back(recordTrees[i].getRoot());
+        }
+        merkleTree.assignRoots(roots);
+        merkleRoot = merkleTree.getRoot();
+    }
+
     // Getter methods
     blockchain::enums::BlockType BlockHeader::getType() const { return type; }
-    std::string BlockHeader::getHash() const { return hash; }
-    std::string BlockHeader::getPrevHash() const { return previousHash; }
-    std::string BlockHeader::getMerkleRoot() const { return merkleRoot; }
+    int BlockHeader::getVersion() const { return version; }
+    std::string BlockHeader::getHash() const { return hash.toHex(); }
+    std::string BlockHeader::getPrevHash() const { return previousHash.toHex(); }
+    std::string BlockHeader::getMerkleRoot() const { return merkleRoot.toHex(); }
+    size_t BlockHeader::getRecordCount() const { return hashing::MerkleTree::splitRecords(informationString).size(); }
+    const hashing::Digest& BlockHeader::getHashDigest() const { return hash; }
+    const hashing::Digest& BlockHeader::getPrevHashDigest() const { return previousHash; }
+    const hashing::Digest& BlockHeader::getMerkleRootDigest() const { return merkleRoot; }
     time_t BlockHeader::getTimestamp() const { return timestamp; }
+    std::string BlockHeader::getBits() const { return bits; }
+    uint64_t BlockHeader::getMiningTime() const { return miningTime; }
     std::string BlockHeader::getFormattedTimestamp() const { return formattedTimestamp; }
     std::string BlockHeader::getInformationString() const { return informationString; }
-    int BlockHeader::getNonce() const { return nonce; }
+    uint32_t BlockHeader::getNonce() const { return nonce; }
     bool BlockHeader::isMined() const { return mined; }
 
     // Setter methods
-    void BlockHeader::setHash(const std::string& hash) { this->hash = hash; }
-    void BlockHeader::setPrevHash(const std::string& prevHash) { this->previousHash = prevHash; }
-    void BlockHeader::setMerkleRoot(const std::string& merkleRoot) { this->merkleRoot = merkleRoot; }
+    void BlockHeader::setHash(const std::string& hash) { this->hash = hashing::Digest::fromHex(hash); }
+    void BlockHeader::setHash(const hashing::Digest& hash) { this->hash = hash; }
+    void BlockHeader::setPrevHash(const std::string& prevHash) { this->previousHash = hashing::Digest::fromHex(prevHash); }
+    void BlockHeader::setPrevHash(const hashing::Digest& prevHash) { this->previousHash = prevHash; }
+    void BlockHeader::setMerkleRoot(const std::string& merkleRoot) { this->merkleRoot = hashing::Digest::fromHex(merkleRoot); }
+    void BlockHeader::setMerkleRoot(const hashing::Digest& merkleRoot) { this->merkleRoot = merkleRoot; }
     void BlockHeader::setTimestamp(time_t timestamp) {
         this->timestamp = timestamp;
         this->formattedTimestamp = utils::Datetime::formatTimestamp(timestamp);
     }
     void BlockHeader::setFormattedTimestamp(const std::string& formattedTimestamp) { this->formattedTimestamp = formattedTimestamp; }
     void BlockHeader::setInformationString(const std::string& informationString) { this->informationString = informationString; }
-    void BlockHeader::setNonce(int nonce) { this->nonce = nonce; }
+    void BlockHeader::setNonce(uint32_t nonce) { this->nonce = nonce; }
+    void BlockHeader::setMiningTime(uint64_t miningTime) { this->miningTime = miningTime; }
     void BlockHeader::setMined(bool mined) { this->mined = mined; }
 } // namespace blockchain
\ No newline at end of file
@@ -3,13 +3,21 @@
 #include <string>
 #include <ctime>
 #include <cstdint>
-#include <vector>
-#include <functional>
 #include "enums/BlockType.h"
+#include "hashing/Digest.h"
+#include "hashing/Hasher.h"
+#include "hashing/MerkleTree.h"
 
 namespace blockchain {
     class BlockHeader {
     public:
+        /**
+         * @brief The first block version whose merkle root is a merkle tree over the records of its information
+         * Every record has a tree over its fields, and the root of the block is a tree over the roots of its records.
+         * Blocks of earlier versions keep the single hash of their whole information string as merkle root.
+         */
+        static const int MERKLE_TREE_VERSION = 2;
+
         /**
          * @brief Construct a new Block Header object
          *
@@ -21,23 +29,25 @@ namespace blockchain {
          * @param hash
          * @param previousHash
          */
-        BlockHeader(blockchain::enums::BlockType type, const int version, const std::string bits, const std::string& informationString, int nonce = 0, const std::string& hash = "", const std::string& previousHash = "");
+        BlockHeader(blockchain::enums::BlockType type, const int version, const std::string bits, const std::string& informationString, uint32_t nonce = 0, const std::string& hash = "", const std::string& previousHash = "");
 
         /**
-         * @brief Get the hash function object
+         * @brief Mine the block
          *
-         * @param type
-         * @return
+         * Rolls the timestamp forward once every 32-bit nonce of the current one has been tried.
+         *
+         * @return The mined hash, or an empty digest if mining was cancelled
          */
-        static std::function<std::string(std::string)> getHashFunction(blockchain::enums::BlockType type);
+        hashing::Digest mine();
 
         /**
-         * @brief Mine the block
+         * @brief Mine the block, as a genesis block or one linked to its predecessor
+         * A genesis header is mined over an all-zero previous hash, as computeHash checks it, and links to the mined hash.
          *
-         * @param hashFunction
-         * @return
+         * @param genesis
+         * @return The mined hash, or an empty digest if mining was cancelled
          */
-        std::string mine(std::function<std::string(std::string)> hashFunction);
+        hashing::Digest mine(bool genesis);
 
         /**
          * @brief Update the editable data
@@ -48,46 +58,153 @@ namespace blockchain {
          */
         BlockHeader& updateEditableData(const std::string informationString, const std::string& prevHash = "");
 
+        /**
+         * @brief Check whether the hash of the block meets the target encoded in its bits
+         *
+         * @return
+         */
+        [[nodiscard]] bool meetsTarget() const;
+
+        /**
+         * @brief Recompute the hash of the header from its fields
+         * A genesis header links to its own hash but was hashed over an all-zero previous hash.
+         *
+         * @param genesis
+         * @return
+         */
+        [[nodiscard]] hashing::Digest computeHash(bool genesis) const;
+
+        /**
+         * @brief Serialize the header the way it is hashed, nonce included
+         * Lets a verifier hash the headers of many blocks at once with the multi-buffer kernels.
+         *
+         * @param buffer Caller-owned storage of at least mining::HeaderLayout<HashAlgorithm::SHA512>::MAX_SIZE bytes
+         * @return The number of bytes written
+         */
+        size_t serialize(uint8_t* buffer) const;
+
+        /**
+         * @brief Recompute the merkle root from the information of the block
+         *
+         * @return
+         */
+        [[nodiscard]] hashing::Digest computeMerkleRoot() const;
+
+        /**
+         * @brief Check whether the merkle root is a merkle tree over the fields of the information
+         *
+         * @return
+         */
+        [[nodiscard]] bool hasMerkleTree() const;
+
+        /**
+         * @brief Get the proof that one field of a record is part of the merkle root
+         * An auditor can check the field against the root with hashing::MerkleTree::verify without the other fields.
+         *
+         * @param recordIndex The position of the record in the information string
+         * @param fieldIndex The position of the field in the record
+         * @return
+         */
+        [[nodiscard]] hashing::MerkleProof proveField(size_t recordIndex, size_t fieldIndex) const;
+
         // setters
         void setHash(const std::string& hash);
+        void setHash(const hashing::Digest& hash);
         void setPrevHash(const std::string& prevHash);
+        void setPrevHash(const hashing::Digest& prevHash);
         void setMerkleRoot(const std::string& merkleRoot);
+        void setMerkleRoot(const hashing::Digest& merkleRoot);
         void setTimestamp(time_t timestamp);
         void setFormattedTimestamp(const std::string& formattedTimestamp);
         void setInformationString(const std::string& informationString);
-        void setNonce(int nonce);
+        void setNonce(uint32_t nonce);
+        void setMiningTime(uint64_t miningTime);
         void setMined(bool mined);
 
         // getters
         [[nodiscard]] blockchain::enums::BlockType getType() const;
+        [[nodiscard]] int getVersion() const;
         [[nodiscard]] std::string getHash() const;
         [[nodiscard]] std::string getPrevHash() const;
         [[nodiscard]] std::string getMerkleRoot() const;
+        [[nodiscard]] size_t getRecordCount() const;
+        [[nodiscard]] const hashing::Digest& getHashDigest() const;
+        [[nodiscard]] const hashing::Digest& getPrevHashDigest() const;
+        [[nodiscard]] const hashing::Digest& getMerkleRootDigest() const;
         [[nodiscard]] time_t getTimestamp() const;
+        [[nodiscard]] std::string getBits() const;
+        [[nodiscard]] uint64_t getMiningTime() const;
         [[nodiscard]] std::string getFormattedTimestamp() const;
         [[nodiscard]] std::string getInformationString() const;
-        [[nodiscard]] int getNonce() const;
+        [[nodiscard]] uint32_t getNonce() const;
         [[nodiscard]] bool isMined() const;
 
     protected:
         blockchain::enums::BlockType type; /** The type of the block */
         int version; /** The version of the block */
         std::string bits; /** The bits which is used for mining */
-        std::string hash; /** The hash of the block */
-        std::string previousHash; /** The previous hash of the block */
-        std::string merkleRoot; /** The merkle root which contains the information of the block */
+        hashing::Digest hash; /** The hash of the block */
+        hashing::Digest previousHash; /** The previous hash of the block */
+        hashing::Digest merkleRoot; /** The merkle root which contains the information of the block */
         time_t timestamp; /** The timestamp of the block */
         std::string formattedTimestamp; /** The formatted timestamp into human-readable datetime of the block */
         std::string informationString; /** The information string of the block */
-        int nonce; /** The nonce of the block */
+        std::vector<hashing::MerkleTree> recordTrees; /** The merkle tree over the fields of every record, none before MERKLE_TREE_VERSION */
+        hashing::MerkleTree merkleTree; /** The merkle tree over the roots of the record trees */
+        uint32_t nonce; /** The nonce of the block, serialized as the last 32 bits of the header */
+        uint64_t miningTime = 0; /** The time it took to mine the block when it was created, in milliseconds */
         bool mined = false; /** Whether if the block is mined */
 
         /**
-         * @brief Generate a new hash based on the hash function
+         * @brief Bring the merkle root up to date with the information string
+         * Only the paths of the fields and records that changed are rehashed in the merkle trees.
+         */
+        void updateMerkleRoot();
+
+        /**
+         * @brief Generate a new hash with the hash algorithm of the block type
          *
-         * @param hashFunction Either uses the SHA256 or the SHA384, or SHA512 hash function
          * @return
          */
-        std::basic_string<char> generateHash(const std::function<std::string(std::string)> &hashFunction) const;
+        [[nodiscard]] hashing::Digest generateHash() const;
+
+        /**
+         * @brief Generate a new hash with a hash algorithm known at compile time
+         *
+         * @tparam Algorithm
+         * @return
+         */
+        template <blockchain::enums::HashAlgorithm Algorithm>
+        [[nodiscard]] hashing::Digest generateHash() const;
+
+        /**
+         * @brief Mine the block with the loop specialized for a hash algorithm
+         *
+         * @tparam Algorithm
+         * @return The mined hash, or an empty digest if mining was cancelled
+         */
+        template <blockchain::enums::HashAlgorithm Algorithm>
+        hashing::Digest mineWith();
+
+        /**
+         * @brief Serialize every header field that precedes the nonce
+         * The prefix stays constant while mining, only the nonce appended to it changes.
+         *
+         * @tparam Algorithm
+         * @param buffer Caller-owned storage of at least mining::HeaderLayout<Algorithm>::MAX_SIZE bytes
+         * @return The number of bytes written
+         */
+        template <blockchain::enums::HashAlgorithm Algorithm>
+        size_t serializeHeaderPrefix(uint8_t* buffer) const;
+
+        /**
+         * @brief Serialize the header with a hash algorithm known at compile time, nonce included
+         *
+         * @tparam Algorithm
+         * @param buffer Caller-owned storage of at least mining::HeaderLayout<Algorithm>::MAX_SIZE bytes
+         * @return The number of bytes written
+         */
+        template <blockchain::enums::HashAlgorithm Algorithm>
+        size_t serialize(uint8_t* buffer) const;
     };
 } // namespace blockchain
\ No newline at end of file
@@ -1,17 +1,24 @@
 #include "Chain.h"
-#include "../filesystem/FileWriter.h"
 #include "enums/BlockAttribute.h"
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 
 namespace blockchain {
+    std::recursive_mutex Chain::mutex;
+
     /**
      * @brief Construct a new Chain object.
      *
      * @param dataFilePath
      * @param version
      * @param bits
+     * @param retargetOptions
+     * @param format
      */
-    Chain::Chain(const std::string dataFilePath, const int version, const std::string& bits) : dataFilePath(dataFilePath), version(version), bits(bits) {}
+    Chain::Chain(const std::string dataFilePath, const int version, const std::string& bits, const mining::RetargetOptions& retargetOptions, filesystem::ChainFormat format)
+            : store(filesystem::ChainStore::open(dataFilePath, format)), version(version), bits(bits), retargetOptions(retargetOptions), difficultyAdjuster(bits, retargetOptions) {}
 
     /**
      * @brief Add a block to the blockchain.
@@ -20,8 +27,11 @@ namespace blockchain {
      * @return
      */
     Chain& Chain::addBlock(std::shared_ptr<Block> block) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         // Set the genesis flag for the block
         block->setGenesis(block->getHeight() == 0);
+        difficultyAdjuster.record(block->getType(), block->getHeader().getBits(), block->getHeader().getMiningTime());
+        accumulator.append(block->getHeader().getHashDigest());
         blocks.push_back(std::move(block));
 
         return *this; // Enable chaining of operations
@@ -35,6 +45,7 @@ namespace blockchain {
      * @return
      */
     Chain& Chain::editBlock(std::shared_ptr<Block> block, const std::string& info) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         auto clonedBlock = block->clone(); // Clone the block to avoid modifying the original
         clonedBlock->getHeader().updateEditableData(info);
 
@@ -43,6 +54,7 @@ namespace blockchain {
         // If found, replace it with the new block
         if (it != blocks.end()) {
             *it = clonedBlock;
+            resyncAccumulator(std::distance(blocks.begin(), it));
         }
 
         return *this; // Enable chaining of operations
@@ -56,6 +68,7 @@ namespace blockchain {
      * @return
      */
     Chain& Chain::hardEditBlock(std::shared_ptr<Block> block, const std::string& info) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         // Find the index of the block that was edited
         auto it = std::find_if(blocks.begin(), blocks.end(),
                                [&block](const std::shared_ptr<Block>& b) {
@@ -79,11 +92,9 @@ namespace blockchain {
         for (size_t i = startIndex + 1; i < blocks.size(); ++i) {
             blocks[i]->getHeader().updateEditableData(blocks[i]->getHeader().getInformationString(), blocks[i - 1]->getHeader().getHash());
         }
+        resyncAccumulator(startIndex);
 
-        filesystem::FileWriter::clearFile(dataFilePath); // Clear the file before writing the updated data
-        for (const auto& itBlock : blocks) {
-            logBlockDetails(*itBlock, dataFilePath);
-        }
+        rewriteRecords(startIndex, blocks.size()); // Every block from the edited one on was relinked
 
         return *this; // Enable chaining of operations
     }
@@ -95,6 +106,10 @@ namespace blockchain {
      * @return
      */
     Chain& Chain::hideBlock(std::shared_ptr<Block> block) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        // The blocks after the first one hidden move down a position in the merkle mountain range
+        const size_t firstHidden = std::distance(blocks.begin(), std::find(blocks.begin(), blocks.end(), block));
+
         // The lambda captures block by value since it's a shared_ptr
         auto it = std::remove_if(blocks.begin(), blocks.end(),
                                  [block](const std::shared_ptr<Block>& itBlock) {
@@ -102,6 +117,7 @@ namespace blockchain {
                                  });
 
         blocks.erase(it, blocks.end()); // Erase the specified block
+        resyncAccumulator(firstHidden);
 
         return *this; // Enable chaining of operations
     }
@@ -114,16 +130,15 @@ namespace blockchain {
      * @return
      */
     Chain& Chain::hardHideBlock(std::shared_ptr<Block> block) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         // The lambda captures block by value since it's a shared_ptr
         auto it = std::find(blocks.begin(), blocks.end(), block);
 
         if (it != blocks.end()) {
             (*it)->setVisible(false);
-        }
 
-        filesystem::FileWriter::clearFile(dataFilePath); // Clear the file before writing the updated data
-        for (const auto& itBlock : blocks) {
-            logBlockDetails(*itBlock, dataFilePath);
+            const size_t index = std::distance(blocks.begin(), it);
+            rewriteRecords(index, index + 1); // Only the flag of the block changed
         }
 
         return *this; // Enable chaining of operations
@@ -136,39 +151,177 @@ namespace blockchain {
      * @return
      */
     Chain& Chain::mineBlock(std::shared_ptr<Block> block) {
-        auto it = std::find(blocks.begin(), blocks.end(), block);
+        // Mine a copy of the header without holding the lock, so the chain stays usable in the meantime
+        std::optional<BlockHeader> header;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex);
+            if (std::find(blocks.begin(), blocks.end(), block) != blocks.end()) {
+                header = block->getHeader();
+            }
+        }
+        if (!header) {
+            return *this;
+        }
 
-        std::string newHash;
-        if (it != blocks.end()) {
-            newHash = (*it)->getHeader().mine(blockchain::BlockHeader::getHashFunction(block->getType()));
-            (*it)->getHeader().setHash(newHash);
+        const hashing::Digest minedFrom = header->getHashDigest();
+        hashing::Digest newHash = header->isMined() ? minedFrom : header->mine(block->isGenesis());
+        if (newHash.empty()) {
+            return *this; // Cancelled or out of nonces, leave the block as it was
+        }
 
-            // If this is the genesis block (the first block), set its prevHash to its new hash
-            if (std::distance(blocks.begin(), it) == 0) {
-                (*it)->getHeader().setPrevHash(newHash);
-            }
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        auto it = std::find(blocks.begin(), blocks.end(), block);
+
+        // A block edited while it was mined keeps its new data, the mined nonce belongs to the old one
+        if (it != blocks.end() && (*it)->getHeader().getHashDigest() == minedFrom) {
+            // A genesis header already links to its new hash
+            header->setHash(newHash);
+            (*it)->getHeader() = *header;
 
             // For subsequent blocks, update the next block's previous hash if there is one
             auto nextIt = std::next(it);
             if (nextIt != blocks.end()) {
                 (*nextIt)->getHeader().setPrevHash(newHash);
             }
-        }
 
-        filesystem::FileWriter::clearFile(dataFilePath); // Clear the file before writing the updated data
-        for (const auto& itBlock : blocks) {
-            logBlockDetails(*itBlock, dataFilePath);
+            const size_t index = std::distance(blocks.begin(), it);
+            resyncAccumulator(index);
+            rewriteRecords(index, std::min(index + 2, blocks.size())); // The block and the link of the next one
         }
 
         return *this; // Enable chaining of operations
     }
 
+    /**
+     * @brief Re-mine a block and every block after it, writing the data file once at the end.
+     *
+     * @param block
+     * @return
+     */
+    bool Chain::cascadeMine(std::shared_ptr<Block> block) {
+        // Mine copies of the headers from the block to the tip without holding the lock
+        std::vector<std::shared_ptr<Block>> cascade;
+        std::vector<BlockHeader> headers;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex);
+            auto it = std::find(blocks.begin(), blocks.end(), block);
+            if (it == blocks.end()) {
+                return false;
+            }
+
+            for (; it != blocks.end(); ++it) {
+                cascade.push_back(*it);
+                headers.push_back((*it)->getHeader());
+            }
+        }
+
+        std::vector<hashing::Digest> minedFrom;
+        for (const auto& header : headers) {
+            minedFrom.push_back(header.getHashDigest());
+        }
+
+        // Blocks that are mined and linked to their predecessor are skipped, so an interrupted cascade resumes where it stopped
+        size_t done = 0;
+        size_t remined = 0;
+        for (; done < headers.size(); ++done) {
+            BlockHeader& header = headers[done];
+            if (done > 0 && header.getPrevHashDigest() != headers[done - 1].getHashDigest()) {
+                header.setPrevHash(headers[done - 1].getHashDigest());
+                header.setMined(false);
+            }
+
+            if (header.isMined()) {
+                continue;
+            }
+
+            std::cout << "Re-mining block " << done + 1 << " of " << headers.size() << " (height " << cascade[done]->getHeight() << ")..." << std::endl;
+            hashing::Digest newHash = header.mine(cascade[done]->isGenesis());
+            if (newHash.empty()) {
+                break; // Cancelled, keep the blocks mined so far
+            }
+
+            header.setHash(newHash);
+            ++remined;
+        }
+
+        if (remined == 0 && done == headers.size()) {
+            std::cout << "Every block from height " << block->getHeight() << " on is already mined to the correct pattern." << std::endl;
+            return true;
+        } else if (remined == 0) {
+            std::cout << "Cascade stopped before mining any block." << std::endl;
+            return false;
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+
+        // Apply the mined headers in order, up to the first block that was edited while the cascade ran
+        std::shared_ptr<Block> lastApplied;
+        size_t applied = 0;
+        for (; applied < done; ++applied) {
+            auto it = std::find(blocks.begin(), blocks.end(), cascade[applied]);
+            if (it == blocks.end() || (*it)->getHeader().getHashDigest() != minedFrom[applied]) {
+                break;
+            }
+
+            (*it)->getHeader() = headers[applied];
+            lastApplied = *it;
+        }
+
+        // The block after the last applied one has to link to its new hash, even if it is not mined yet
+        auto lastIt = std::find(blocks.begin(), blocks.end(), lastApplied);
+        if (lastIt != blocks.end() && std::next(lastIt) != blocks.end()) {
+            BlockHeader& next = (*std::next(lastIt))->getHeader();
+            if (next.getPrevHashDigest() != (*lastIt)->getHeader().getHashDigest()) {
+                next.setPrevHash((*lastIt)->getHeader().getHashDigest());
+                next.setMined(false);
+            }
+        }
+
+        if (applied > 0) {
+            // Rewritten once for the whole cascade, from its first block to the one linked to the last applied
+            const size_t firstIndex = std::distance(blocks.begin(), std::find(blocks.begin(), blocks.end(), cascade[0]));
+            const size_t lastIndex = std::distance(blocks.begin(), lastIt);
+            resyncAccumulator(firstIndex);
+            rewriteRecords(firstIndex, std::min(lastIndex + 2, blocks.size()));
+        }
+
+        if (applied < headers.size()) {
+            std::cout << "Cascade stopped after " << applied << " of " << headers.size() << " blocks, mine the edited blocks again to resume." << std::endl;
+            return false;
+        }
+
+        std::cout << "Cascade re-mined " << remined << " of " << headers.size() << " blocks." << std::endl;
+        return true;
+    }
+
+    /**
+     * @brief Append a freshly mined block if it still extends the tip of the chain.
+     *
+     * @param block
+     * @return
+     */
+    bool Chain::commitBlock(std::shared_ptr<Block> block) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+
+        // A genesis block links to itself, any other block to the current tip
+        bool extendsTip = blocks.empty()
+                ? block->getHeight() == 0
+                : block->getHeight() == getNextBlockHeight() && block->getHeader().getPrevHash() == getLastBlockHash();
+        if (!extendsTip) {
+            return false;
+        }
+
+        addBlock(block).addToRecord();
+        return true;
+    }
+
     /**
      * @brief Check if the blockchain is empty.
      *
      * @return
      */
     bool Chain::isEmpty() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         return blocks.empty();
     }
 
@@ -176,6 +329,7 @@ namespace blockchain {
      * @brief Display all blocks in the blockchain.
      */
     void Chain::displayAll() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if (hasVisibleBlocks(blocks)) {
             std::cout << std::endl << "------------------------------------ BLOCKCHAIN ------------------------------------" << std::endl << std::endl;
             for (const auto& block : blocks) {
@@ -195,6 +349,7 @@ namespace blockchain {
      * @param selectedBlocks
      */
     void Chain::display(const std::vector<std::shared_ptr<Block>>& selectedBlocks) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if (!selectedBlocks.empty() && hasVisibleBlocks(selectedBlocks)) {
             std::cout << "------------------------------------ SELECTED BLOCKS ------------------------------------" << std::endl << std::endl;
 
@@ -230,6 +385,7 @@ namespace blockchain {
      * @return
      */
     std::vector<std::shared_ptr<Block>> Chain::searchBlockByAttr(blockchain::enums::BlockAttribute attribute, const std::string& value) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         std::vector<std::shared_ptr<Block>> foundBlocks; // Store shared pointers to the found blocks
 
         // Iterate through the blocks and search for the specified attribute
@@ -247,7 +403,7 @@ namespace blockchain {
                     found = attrValue == value;
                     break;
                 case blockchain::enums::BlockAttribute::VERSION:
-                    attrValue = std::to_string(version);
+                    attrValue = std::to_string(block->getHeader().getVersion());
                     found = attrValue == value;
                     break;
                 case blockchain::enums::BlockAttribute::NONCE:
@@ -276,7 +432,7 @@ namespace blockchain {
                     }
                     break;
                 case blockchain::enums::BlockAttribute::BITS:
-                    attrValue = bits;
+                    attrValue = block->getHeader().getBits();
                     found = attrValue == value;
                     break;
                 case blockchain::enums::BlockAttribute::INFORMATION:
@@ -290,6 +446,10 @@ namespace blockchain {
                 case enums::BlockAttribute::VISIBLE:
                     // Visibility not needed to be shown to the users
                     break;
+                case enums::BlockAttribute::MINING_TIME:
+                    attrValue = std::to_string(block->getHeader().getMiningTime());
+                    found = attrValue == value;
+                    break;
             }
 
             if (found) {
@@ -309,15 +469,16 @@ namespace blockchain {
     void Chain::displayBlockDetails(const std::shared_ptr<Block> &block) const {
         std::cout << enums::BlockAttributeUtils::toString(enums::BlockAttribute::TYPE) << " --> " << enums::BlockTypeUtils ::toString(block->getType()) << std::endl
                   << enums::BlockAttributeUtils::toString(enums::BlockAttribute::HEIGHT) << " --> " << block->getHeight() << (block->isGenesis() ? " (Genesis Block)" : "") << std::endl
-                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::VERSION) << " --> " << version << std::endl
+                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::VERSION) << " --> " << block->getHeader().getVersion() << std::endl
                   << enums::BlockAttributeUtils::toString(enums::BlockAttribute::NONCE) << " --> " << block->getNonce() << std::endl
-                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::HASH) << " --> " << block->getHeader().getHash() << std::endl
-                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::PREV_HASH) << " --> " << block->getHeader().getPrevHash() << std::endl
-                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::MERKLE_ROOT) << " --> " << block->getHeader().getMerkleRoot() << std::endl
+                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::HASH) << " --> " << block->getHeader().getHashDigest() << std::endl
+                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::PREV_HASH) << " --> " << block->getHeader().getPrevHashDigest() << std::endl
+                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::MERKLE_ROOT) << " --> " << block->getHeader().getMerkleRootDigest() << std::endl
                   << enums::BlockAttributeUtils::toString(enums::BlockAttribute::TIMESTAMP) << " --> " << block->getHeader().getTimestamp() << " (" + block->getHeader().getFormattedTimestamp() + ")" << std::endl
-                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::BITS) << " --> " << bits << std::endl
+                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::BITS) << " --> " << block->getHeader().getBits() << std::endl
                   << enums::BlockAttributeUtils::toString(enums::BlockAttribute::INFORMATION) << " --> " << "[ " << block->getHeader().getInformationString() << " ]" << std::endl
-                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::MINED) << " --> " << (block->getHeader().isMined() ? "Yes" : "No") << std::endl << std::endl;
+                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::MINED) << " --> " << (block->getHeader().isMined() ? "Yes" : "No") << std::endl
+                  << enums::BlockAttributeUtils::toString(enums::BlockAttribute::MINING_TIME) << " --> " << block->getHeader().getMiningTime() << " ms" << std::endl << std::endl;
     }
 
     /**
@@ -326,9 +487,117 @@ namespace blockchain {
      * @return int The height of the next block in the chain.
      */
     int Chain::getNextBlockHeight() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         return static_cast<int>(blocks.size());
     }
 
+    /**
+     * @brief Get the bits the next block of a type has to be mined with.
+     *
+     * @param type
+     * @return
+     */
+    std::string Chain::getNextBits(blockchain::enums::BlockType type) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        return difficultyAdjuster.getNextBits(type);
+    }
+
+    /**
+     * @brief Check that every block was mined with the bits the retargeting gives it and meets its target.
+     *
+     * @return
+     */
+    bool Chain::verifyTargets() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        mining::DifficultyAdjuster replay(bits, retargetOptions);
+
+        for (const auto& block : blocks) {
+            const BlockHeader& header = block->getHeader();
+            if (header.getBits() != replay.getNextBits(block->getType()) || !header.meetsTarget()) {
+                return false;
+            }
+            replay.record(block->getType(), header.getBits(), header.getMiningTime());
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Check that every block's stored hash, previous hash and merkle root match its header and information.
+     *
+     * @param threads
+     * @return
+     */
+    verification::VerificationReport Chain::verify(unsigned int threads) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        return verification::ChainVerifier(threads).verify(blocks);
+    }
+
+    /**
+     * @brief Get the root of the merkle mountain range over the hashes of the blocks.
+     *
+     * @return
+     */
+    hashing::Digest Chain::getAccumulatorRoot() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        return accumulator.getRoot();
+    }
+
+    /**
+     * @brief Get the number of block hashes in the merkle mountain range.
+     *
+     * @return
+     */
+    uint64_t Chain::getAccumulatorSize() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        return accumulator.getSize();
+    }
+
+    /**
+     * @brief Get the proof that the hash of a block is part of the merkle mountain range.
+     *
+     * @param height
+     * @return
+     */
+    BlockInclusionProof Chain::proveInclusion(int height) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        auto it = std::find_if(blocks.begin(), blocks.end(), [height](const std::shared_ptr<Block>& block) {
+            return block->getHeight() == height;
+        });
+
+        if (it == blocks.end()) {
+            throw std::runtime_error("No block found at height " + std::to_string(height) + ".");
+        }
+        return {(*it)->getHeader().getHashDigest(), accumulator.getRoot(), accumulator.getSize(), accumulator.proveInclusion(std::distance(blocks.begin(), it))};
+    }
+
+    /**
+     * @brief Get the proof that the chain grew from its first blocks by appending only.
+     *
+     * @param oldSize
+     * @return
+     */
+    hashing::MmrConsistencyProof Chain::proveConsistency(uint64_t oldSize) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        if (oldSize == 0 || oldSize > accumulator.getSize()) {
+            throw std::runtime_error("The chain never held " + std::to_string(oldSize) + " blocks.");
+        }
+        return accumulator.proveConsistency(oldSize);
+    }
+
+    /**
+     * @brief Rebuild the merkle mountain range from a position on.
+     * Only the peaks covering the changed blocks are rehashed, an edit near the tip costs O(log n) hashes.
+     *
+     * @param from
+     */
+    void Chain::resyncAccumulator(size_t from) {
+        accumulator.truncate(from);
+        for (size_t i = accumulator.getSize(); i < blocks.size(); ++i) {
+            accumulator.append(blocks[i]->getHeader().getHashDigest());
+        }
+    }
+
     /**
      * @brief Get a block by its height in the chain.
      *
@@ -336,6 +605,7 @@ namespace blockchain {
      * @return
      */
     std::shared_ptr<Block> Chain::getBlockByHeight(int height) {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if (height >= 0 && height < blocks.size()) {
             return blocks[height];
         }
@@ -349,6 +619,7 @@ namespace blockchain {
      * @return std::string The hash of the last block in the chain.
      */
     std::string Chain::getLastBlockHash() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if (!blocks.empty()) {
             return blocks.back()->getHeader().getHash();
         }
@@ -356,38 +627,67 @@ namespace blockchain {
     }
 
     /**
-     * @brief Log the details of a block to a file.
+     * @brief Get the record of a block in the blockchain data file.
+     *
+     * @param block The block to record.
+     * @return
+     */
+    filesystem::BlockData Chain::toBlockData(const Block& block) {
+        const BlockHeader& header = block.getHeader();
+
+        filesystem::BlockData record;
+        record.type = block.getType();
+        record.height = block.getHeight();
+        record.version = header.getVersion();
+        record.nonce = block.getNonce();
+        record.currentHash = header.getHash();
+        record.previousHash = header.getPrevHash();
+        record.merkleRoot = header.getMerkleRoot();
+        record.timestamp = std::to_string(header.getTimestamp());
+        record.bits = header.getBits();
+        record.information = header.getInformationString();
+        record.mined = header.isMined();
+        record.visible = block.isVisible();
+        record.miningTime = header.getMiningTime();
+        return record;
+    }
+
+    /**
+     * @brief Rewrite the records of a range of blocks in the blockchain data file.
      *
-     * @param block The block to log.
-     * @param filename The name of the file to write (log) to.
+     * @param first
+     * @param last
      */
-    void Chain::logBlockDetails(const Block& block, const std::string& filename) {
-        using namespace blockchain::enums; // Use the entire namespace
-
-        filesystem::FileWriter writer(filename);
-
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::TYPE) + ": " + blockchain::enums::BlockTypeUtils::toString(block.getType()));
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::HEIGHT) + ": " + std::to_string(block.getHeight()));
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::VERSION) + ": " + std::to_string(version));
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::NONCE) + ": " + std::to_string(block.getNonce()));
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::HASH) + ": " + block.getHeader().getHash());
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::PREV_HASH) + ": " + block.getHeader().getPrevHash());
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::MERKLE_ROOT) + ": " + block.getHeader().getMerkleRoot());
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::TIMESTAMP) + ": " + std::to_string(block.getHeader().getTimestamp()));
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::BITS) + ": " + bits);
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::INFORMATION) + ": " + block.getHeader().getInformationString());
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::MINED) + ": " + (block.getHeader().isMined() ? "true" : "false"));
-        writer.writeLine(BlockAttributeUtils::toString(BlockAttribute::VISIBLE) + ": " + (block.isVisible() ? "true" : "false"));
-        writer.writeLine(""); // Add an empty line for readability
+    void Chain::rewriteRecords(size_t first, size_t last) {
+        // A file out of step with the chain, one whose blocks were added without being recorded, is rewritten whole
+        const bool inStep = store->getRecordCount() == blocks.size();
+        if (!inStep) {
+            first = 0;
+            last = blocks.size();
+        }
+
+        std::vector<filesystem::BlockData> records;
+        records.reserve(last - first);
+        for (size_t i = first; i < last; ++i) {
+            records.push_back(toBlockData(*blocks[i]));
+        }
+
+        if (inStep) {
+            store->update(first, records);
+        } else {
+            store->clear();
+            store->append(records);
+        }
     }
 
     /**
      * @brief Add the blockchain to the record.
      */
     void Chain::addToRecord() {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if (!blocks.empty()) {
             const auto& block = blocks.back();
-            logBlockDetails(*block, dataFilePath);
+            store->append(toBlockData(*block));
         }
     }
 }
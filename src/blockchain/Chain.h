@@ -2,10 +2,25 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 #include "Block.h"
+#include "../filesystem/ChainStore.h"
 #include "enums/BlockAttribute.h"
+#include "hashing/MerkleMountainRange.h"
+#include "mining/DifficultyAdjuster.h"
+#include "verification/ChainVerifier.h"
 
 namespace blockchain {
+    /**
+     * @brief The proof that a block is part of a chain, with the root and size of the range it was taken from.
+     */
+    struct BlockInclusionProof {
+        hashing::Digest blockHash; /** The hash of the block, the leaf being proven */
+        hashing::Digest root; /** The root of the merkle mountain range when the proof was taken */
+        uint64_t size = 0; /** The number of blocks in the range when the proof was taken */
+        hashing::MerkleProof proof; /** The leaf index is the position of the block in the chain */
+    };
+
     class Chain {
     public:
         /**
@@ -18,9 +33,11 @@ namespace blockchain {
          *
          * @param dataFilePath
          * @param version
-         * @param bits
+         * @param bits The bits of the first block of every type, later blocks follow the retargeting
+         * @param retargetOptions
+         * @param format The format of the data file if it has no blocks yet, an existing file keeps its own
          */
-        Chain(const std::string dataFilePath, const int version, const std::string& bits = "ffff001f");
+        Chain(const std::string dataFilePath, const int version, const std::string& bits = "ffff001f", const mining::RetargetOptions& retargetOptions = mining::RetargetOptions(), filesystem::ChainFormat format = filesystem::ChainFormat::TEXT);
 
         /**
          * @brief Add a block to the blockchain.
@@ -40,7 +57,8 @@ namespace blockchain {
         Chain& editBlock(std::shared_ptr<Block> block, const std::string& info);
 
         /**
-         * @brief "Removes" a block from the blockchain by flagging it as invisible.
+         * @brief Edit a block in the blockchain with verifiable and persistent changes.
+         * The block and every block after it are relinked but left unmined, see cascadeMine.
          *
          * @param block
          * @param info
@@ -68,12 +86,32 @@ namespace blockchain {
 
         /**
          * @brief Mine a block in the blockchain.
+         * The block is mined outside the lock of the chain, the result is dropped if the block was edited meanwhile.
          *
          * @param block
          * @return
          */
         Chain& mineBlock(std::shared_ptr<Block> block);
 
+        /**
+         * @brief Append a freshly mined block and record it, if it still extends the tip of the chain.
+         * Blocks mined in the background may have been overtaken by changes to the chain.
+         *
+         * @param block
+         * @return Whether the block was appended
+         */
+        bool commitBlock(std::shared_ptr<Block> block);
+
+        /**
+         * @brief Re-mine a block and every block after it in order, relinking each to its re-mined predecessor.
+         * Each block is searched with every worker of the MiningEngine, and the data file is written once at the end.
+         * Blocks already mined and linked are skipped, so a cancelled cascade resumes where it stopped when run again.
+         *
+         * @param block
+         * @return Whether every block from the given one to the tip is mined
+         */
+        bool cascadeMine(std::shared_ptr<Block> block);
+
         /**
          * @brief Display all blocks in the blockchain.
          */
@@ -133,11 +171,73 @@ namespace blockchain {
 
         [[nodiscard]] std::string getBits() const { return bits; }
 
+        /**
+         * @brief Get the bits the next block of a type has to be mined with.
+         *
+         * @param type
+         * @return
+         */
+        [[nodiscard]] std::string getNextBits(blockchain::enums::BlockType type) const;
+
+        /**
+         * @brief Check that every block was mined with the bits the retargeting gives it and meets its target.
+         * Replays the recorded bits and mining times of the blocks in order.
+         *
+         * @return
+         */
+        [[nodiscard]] bool verifyTargets() const;
+
+        /**
+         * @brief Check that every block's stored hash, previous hash and merkle root match its header and information.
+         * The blocks are split across a pool of threads, the chain is locked meanwhile.
+         *
+         * @param threads The number of threads checking blocks, 0 uses every hardware thread
+         * @return
+         */
+        [[nodiscard]] verification::VerificationReport verify(unsigned int threads = 0) const;
+
+        /**
+         * @brief Get the root of the merkle mountain range over the hashes of the blocks, in chain order.
+         *
+         * @return
+         */
+        [[nodiscard]] hashing::Digest getAccumulatorRoot() const;
+
+        /**
+         * @brief Get the number of block hashes in the merkle mountain range.
+         *
+         * @return
+         */
+        [[nodiscard]] uint64_t getAccumulatorSize() const;
+
+        /**
+         * @brief Get the proof that the hash of a block is part of the merkle mountain range.
+         * Throws if no block of the chain has the height.
+         *
+         * @param height
+         * @return
+         */
+        [[nodiscard]] BlockInclusionProof proveInclusion(int height) const;
+
+        /**
+         * @brief Get the proof that the chain grew from its first blocks by appending only.
+         *
+         * @param oldSize The number of blocks the earlier root was taken over
+         * @return
+         */
+        [[nodiscard]] hashing::MmrConsistencyProof proveConsistency(uint64_t oldSize) const;
+
     private:
         /**
-         * @brief The path to the blockchain data file.
+         * @brief Guards the blocks against the background mining jobs.
+         * Shared by every chain since the chains share their blocks.
          */
-        const std::string dataFilePath;
+        static std::recursive_mutex mutex;
+
+        /**
+         * @brief The blockchain data file, in the text or binary record format.
+         */
+        std::unique_ptr<filesystem::ChainStore> store;
 
         /**
          * @brief The version number indicating which set of block validation rules to follow.
@@ -149,17 +249,49 @@ namespace blockchain {
          */
         std::string bits;
 
+        /**
+         * @brief The tunables of the difficulty retargeting.
+         */
+        mining::RetargetOptions retargetOptions;
+
+        /**
+         * @brief Tracks the mining times of the blocks to derive the bits of the next block of each type.
+         */
+        mining::DifficultyAdjuster difficultyAdjuster;
+
         /**
          * @brief The list of blocks in the blockchain.
          */
         std::vector<std::shared_ptr<Block>> blocks;
 
         /**
-         * @brief The list of blocks in the blockchain.
+         * @brief The merkle mountain range over the hashes of the blocks, partners verify the chain against its root.
+         */
+        hashing::MerkleMountainRange accumulator;
+
+        /**
+         * @brief Rebuild the merkle mountain range from a position on, after the blocks from there were changed.
+         *
+         * @param from
+         */
+        void resyncAccumulator(size_t from);
+
+        /**
+         * @brief Get the record of a block in the blockchain data file.
+         *
          * @param block
-         * @param filename
+         * @return
+         */
+        static filesystem::BlockData toBlockData(const Block& block);
+
+        /**
+         * @brief Rewrite the records of the blocks from first up to last (excluded) in the blockchain data file.
+         * The records after them are only rewritten if the size of a rewritten record changed.
+         *
+         * @param first
+         * @param last
          */
-        void logBlockDetails(const Block& block, const std::string& filename);
+        void rewriteRecords(size_t first, size_t last);
 
         /**
          * @brief Display the details of a block.
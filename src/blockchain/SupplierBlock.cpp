@@ -2,8 +2,12 @@
 #include <sstream>
 
 namespace blockchain {
-    SupplierBlock::SupplierBlock(const int version, const std::string bits, int height, const std::string& previousHash, const SupplierInfo& info, int nonce, const std::string& currentHash, bool visible)
-            : Block(version, bits, height, previousHash, info.toString(), blockchain::enums::BlockType::SUPPLIER, nonce, currentHash, visible), info(info) {
+    SupplierBlock::SupplierBlock(const int version, const std::string bits, int height, const std::string& previousHash, const SupplierInfo& info, uint32_t nonce, const std::string& currentHash, bool visible)
+            : SupplierBlock(version, bits, height, previousHash, std::vector<SupplierInfo>{info}, nonce, currentHash, visible) {
+    }
+
+    SupplierBlock::SupplierBlock(const int version, const std::string bits, int height, const std::string& previousHash, const std::vector<SupplierInfo>& records, uint32_t nonce, const std::string& currentHash, bool visible)
+            : Block(version, bits, height, previousHash, joinRecords(records), blockchain::enums::BlockType::SUPPLIER, nonce, currentHash, visible), records(records) {
         // The constructor initializes the Block part with formatted supplier information
     }
 
@@ -18,6 +22,10 @@ namespace blockchain {
     }
 
     SupplierInfo SupplierBlock::getInfo() const {
-        return info;
+        return records.front();
+    }
+
+    const std::vector<SupplierInfo>& SupplierBlock::getRecords() const {
+        return records;
     }
 }
@@ -48,15 +48,36 @@ namespace blockchain {
          * @param nonce
          * @param currenHash
          */
-        SupplierBlock(const int version, const std::string bits, int height, const std::string& previousHash, const SupplierInfo& info, int nonce = 0, const std::string& currenHash = "", bool visible = true);
+        SupplierBlock(const int version, const std::string bits, int height, const std::string& previousHash, const SupplierInfo& info, uint32_t nonce = 0, const std::string& currenHash = "", bool visible = true);
 
         /**
-         * @brief Get the supplier information.
+         * @brief Construct a new Supplier Block object holding several records under one merkle root
+         *
+         * @param version
+         * @param bits
+         * @param height
+         * @param previousHash
+         * @param records At least one record
+         * @param nonce
+         * @param currentHash
+         * @param visible
+         */
+        SupplierBlock(const int version, const std::string bits, int height, const std::string& previousHash, const std::vector<SupplierInfo>& records, uint32_t nonce = 0, const std::string& currentHash = "", bool visible = true);
+
+        /**
+         * @brief Get the supplier information of the first record.
          *
          * @return SupplierInfo
          */
         SupplierInfo getInfo() const;
 
+        /**
+         * @brief Get every record of the block.
+         *
+         * @return
+         */
+        const std::vector<SupplierInfo>& getRecords() const;
+
         /**
          * @brief Provide a deep copy of the current block.
          *
@@ -68,8 +89,8 @@ namespace blockchain {
 
     private:
         /**
-         * This field holds the raw supplier information.
+         * This field holds the raw supplier information of every record.
          */
-        SupplierInfo info;
+        std::vector<SupplierInfo> records;
     };
 }
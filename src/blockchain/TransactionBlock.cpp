@@ -1,8 +1,12 @@
 #include "TransactionBlock.h"
 
 namespace blockchain {
-    TransactionBlock::TransactionBlock(const int version, const std::string bits, int height, const std::string& previousHash, TransactionInfo& info, int nonce, const std::string& currentHash, bool visible)
-            : Block(version, bits, height, previousHash, info.toString(), blockchain::enums::BlockType::TRANSACTION, nonce, currentHash, visible), info(info) {
+    TransactionBlock::TransactionBlock(const int version, const std::string bits, int height, const std::string& previousHash, TransactionInfo& info, uint32_t nonce, const std::string& currentHash, bool visible)
+            : TransactionBlock(version, bits, height, previousHash, std::vector<TransactionInfo>{info}, nonce, currentHash, visible) {
+    }
+
+    TransactionBlock::TransactionBlock(const int version, const std::string bits, int height, const std::string& previousHash, const std::vector<TransactionInfo>& records, uint32_t nonce, const std::string& currentHash, bool visible)
+            : Block(version, bits, height, previousHash, joinRecords(records), blockchain::enums::BlockType::TRANSACTION, nonce, currentHash, visible), records(records) {
         // No additional initialization needed here
     }
 
@@ -19,6 +23,10 @@ namespace blockchain {
     }
 
     TransactionInfo TransactionBlock::getInfo() const {
-        return info;
+        return records.front();
+    }
+
+    const std::vector<TransactionInfo>& TransactionBlock::getRecords() const {
+        return records;
     }
 }
@@ -55,15 +55,36 @@ namespace blockchain {
          * @param currentHash
          * @param visible
          */
-        TransactionBlock(const int version, const std::string bits,int height, const std::string& previousHash, TransactionInfo& info, int nonce = 0, const std::string& currentHash = "", bool visible = true);
+        TransactionBlock(const int version, const std::string bits,int height, const std::string& previousHash, TransactionInfo& info, uint32_t nonce = 0, const std::string& currentHash = "", bool visible = true);
 
         /**
-         * @brief Get the transaction information.
+         * @brief Construct a new Transaction Block object holding several records under one merkle root
+         *
+         * @param version
+         * @param bits
+         * @param height
+         * @param previousHash
+         * @param records At least one record
+         * @param nonce
+         * @param currentHash
+         * @param visible
+         */
+        TransactionBlock(const int version, const std::string bits, int height, const std::string& previousHash, const std::vector<TransactionInfo>& records, uint32_t nonce = 0, const std::string& currentHash = "", bool visible = true);
+
+        /**
+         * @brief Get the transaction information of the first record.
          *
          * @return
          */
         TransactionInfo getInfo() const;
 
+        /**
+         * @brief Get every record of the block.
+         *
+         * @return
+         */
+        const std::vector<TransactionInfo>& getRecords() const;
+
         /**
          * @brief Clone the TransactionBlock object
          *
@@ -74,6 +95,6 @@ namespace blockchain {
         }
 
     protected:
-        TransactionInfo info; /** The header information of the Transaction */
+        std::vector<TransactionInfo> records; /** The header information of every Transaction record */
     };
 }
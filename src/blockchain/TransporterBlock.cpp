@@ -1,8 +1,12 @@
 #include "TransporterBlock.h"
 
 namespace blockchain {
-    TransporterBlock::TransporterBlock(const int version, const std::string bits, int height, const std::string& previousHash, const TransporterInfo& info, int nonce, const std::string& currentHash, bool visible)
-            : Block(version, bits, height, previousHash, info.toString(), blockchain::enums::BlockType::TRANSPORTER, nonce, currentHash, visible), info(info) {
+    TransporterBlock::TransporterBlock(const int version, const std::string bits, int height, const std::string& previousHash, const TransporterInfo& info, uint32_t nonce, const std::string& currentHash, bool visible)
+            : TransporterBlock(version, bits, height, previousHash, std::vector<TransporterInfo>{info}, nonce, currentHash, visible) {
+    }
+
+    TransporterBlock::TransporterBlock(const int version, const std::string bits, int height, const std::string& previousHash, const std::vector<TransporterInfo>& records, uint32_t nonce, const std::string& currentHash, bool visible)
+            : Block(version, bits, height, previousHash, joinRecords(records), blockchain::enums::BlockType::TRANSPORTER, nonce, currentHash, visible), records(records) {
         // No additional initialization needed here
     }
 
@@ -18,6 +22,10 @@ namespace blockchain {
     }
 
     TransporterInfo TransporterBlock::getInfo() const {
-        return info;
+        return records.front();
+    }
+
+    const std::vector<TransporterInfo>& TransporterBlock::getRecords() const {
+        return records;
     }
 }
@@ -53,15 +53,36 @@ namespace blockchain {
          * @param currentHash
          * @param visible
          */
-        TransporterBlock(const int version, const std::string bits, int height, const std::string& previousHash, const TransporterInfo& info, int nonce = 0, const std::string& currentHash = "", bool visible = true);
+        TransporterBlock(const int version, const std::string bits, int height, const std::string& previousHash, const TransporterInfo& info, uint32_t nonce = 0, const std::string& currentHash = "", bool visible = true);
 
         /**
-         * @brief Get the transporter information.
+         * @brief Construct a new Transporter Block object holding several records under one merkle root
+         *
+         * @param version
+         * @param bits
+         * @param height
+         * @param previousHash
+         * @param records At least one record
+         * @param nonce
+         * @param currentHash
+         * @param visible
+         */
+        TransporterBlock(const int version, const std::string bits, int height, const std::string& previousHash, const std::vector<TransporterInfo>& records, uint32_t nonce = 0, const std::string& currentHash = "", bool visible = true);
+
+        /**
+         * @brief Get the transporter information of the first record.
          *
          * @return
          */
         TransporterInfo getInfo() const;
 
+        /**
+         * @brief Get every record of the block.
+         *
+         * @return
+         */
+        const std::vector<TransporterInfo>& getRecords() const;
+
         /**
          * @brief Make a deep copy the TransporterBlock object
          *
@@ -72,6 +93,6 @@ namespace blockchain {
         }
 
     private:
-        TransporterInfo info; /** header information about the transporter */
+        std::vector<TransporterInfo> records; /** header information about the transporter of every record */
     };
 }
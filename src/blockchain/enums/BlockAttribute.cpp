@@ -29,6 +29,8 @@ namespace blockchain::enums {
             return BlockAttribute::MINED;
         } else if (attributeString == "Visible") {
             return BlockAttribute::VISIBLE;
+        } else if (attributeString == "Mining Time") {
+            return BlockAttribute::MINING_TIME;
         } else {
             throw std::invalid_argument("Unknown BlockAttribute");
         }
@@ -61,6 +63,8 @@ namespace blockchain::enums {
                 return "Mined";
             case BlockAttribute::VISIBLE:
                 return "Visible";
+            case BlockAttribute::MINING_TIME:
+                return "Mining Time";
             default:
                 throw std::invalid_argument("Unknown BlockAttribute");
         }
@@ -20,6 +20,7 @@ namespace blockchain::enums {
         INFORMATION,
         MINED,
         VISIBLE,
+        MINING_TIME,
     };
 
     class BlockAttributeUtils {
@@ -0,0 +1,18 @@
+#include "MiningPriority.h"
+#include <stdexcept>
+
+namespace blockchain::enums {
+    std::string MiningPriorityUtils::toString(MiningPriority priority) {
+        // Convert the MiningPriority to the corresponding string
+        switch (priority) {
+            case MiningPriority::LOW:
+                return "Low";
+            case MiningPriority::NORMAL:
+                return "Normal";
+            case MiningPriority::HIGH:
+                return "High";
+            default:
+                throw std::invalid_argument("Unknown MiningPriority");
+        }
+    }
+}
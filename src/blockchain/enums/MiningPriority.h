@@ -0,0 +1,29 @@
+#ifndef MININGPRIORITY_H
+#define MININGPRIORITY_H
+
+#include <string>
+
+namespace blockchain::enums {
+    /**
+     * @brief Enum class for MiningPriority
+     * Queued mining jobs with a higher priority run first.
+     */
+    enum class MiningPriority {
+        LOW,
+        NORMAL,
+        HIGH,
+    };
+
+    class MiningPriorityUtils {
+    public:
+        /**
+         * Convert a MiningPriority to a string
+         *
+         * @param priority
+         * @return
+         */
+        static std::string toString(MiningPriority priority);
+    };
+} // namespace blockchain
+
+#endif // MININGPRIORITY_H
@@ -0,0 +1,44 @@
+#include "Digest.h"
+#include <algorithm>
+#include <stdexcept>
+#include "../../../libs/hex/hex.h"
+
+namespace blockchain::hashing {
+    Digest Digest::fromHex(std::string_view hex) {
+        // Decoded straight into the storage, so the length has to fit it first
+        Digest digest;
+        if (hex.length() / 2 > MAX_SIZE || !Hex::decode(hex.data(), hex.length(), digest.bytes.data())) {
+            throw std::runtime_error("Invalid hexadecimal string.");
+        }
+
+        digest.size = hex.length() / 2;
+        return digest;
+    }
+
+    std::string Digest::toHex() const {
+        std::string hex(size * 2, '0');
+        toHex(hex.data());
+        return hex;
+    }
+
+    void Digest::toHex(char* out) const {
+        Hex::encode(bytes.data(), size, out);
+    }
+
+    bool Digest::empty() const { return size == 0; }
+    const uint8_t* Digest::data() const { return bytes.data(); }
+
+    bool Digest::operator==(const Digest& other) const {
+        return size == other.size && std::equal(bytes.begin(), bytes.begin() + size, other.bytes.begin());
+    }
+
+    bool Digest::operator!=(const Digest& other) const {
+        return !(*this == other);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const Digest& digest) {
+        char hex[Digest::MAX_SIZE * 2];
+        digest.toHex(hex);
+        return os.write(hex, static_cast<std::streamsize>(digest.size * 2));
+    }
+} // namespace blockchain::hashing
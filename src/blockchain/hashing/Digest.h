@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace blockchain::hashing {
+    /**
+     * @brief A binary hash digest held in fixed-size storage
+     * Large enough for any of the SHA-2 digests the blocks use, so producing one never allocates.
+     */
+    struct Digest {
+        static const size_t MAX_SIZE = 64; /** The size of a SHA-512 digest, the largest supported */
+
+        std::array<uint8_t, MAX_SIZE> bytes{}; /** The digest bytes, only the first size bytes are meaningful */
+        size_t size = 0; /** The number of bytes in the digest, 0 when no hash is set */
+
+        /**
+         * @brief Parse a digest from its hexadecimal representation
+         * Used at the boundaries where hashes come in as text (data files, user input).
+         *
+         * @param hex
+         * @return
+         */
+        static Digest fromHex(std::string_view hex);
+
+        /**
+         * @brief Convert the digest to its lowercase hexadecimal representation
+         * Used at the display and serialization boundaries only.
+         *
+         * @return
+         */
+        [[nodiscard]] std::string toHex() const;
+
+        /**
+         * @brief Write the lowercase hexadecimal representation of the digest to a buffer
+         *
+         * @param out Holds at least 2 * size characters, no terminating null is written
+         */
+        void toHex(char* out) const;
+
+        /**
+         * @brief Check whether no hash is set
+         *
+         * @return
+         */
+        [[nodiscard]] bool empty() const;
+
+        /**
+         * @brief Get a pointer to the digest bytes
+         *
+         * @return
+         */
+        [[nodiscard]] const uint8_t* data() const;
+
+        bool operator==(const Digest& other) const;
+        bool operator!=(const Digest& other) const;
+    };
+
+    /**
+     * @brief Print the digest in hexadecimal without building a string
+     *
+     * @param os
+     * @param digest
+     * @return
+     */
+    std::ostream& operator<<(std::ostream& os, const Digest& digest);
+} // namespace blockchain::hashing
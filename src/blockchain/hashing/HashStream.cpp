@@ -0,0 +1,43 @@
+#include "HashStream.h"
+#include <type_traits>
+
+namespace blockchain::hashing {
+    HashStream::HashStream(blockchain::enums::HashAlgorithm algorithm) : algorithm(algorithm) {
+        reset();
+    }
+
+    void HashStream::update(const uint8_t* data, size_t length) {
+        std::visit([data, length](auto& ctx) { ctx.update(data, length); }, context);
+    }
+
+    void HashStream::update(std::string_view data) {
+        update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    }
+
+    void HashStream::final(Digest& digest) {
+        std::visit([&digest](auto& ctx) {
+            ctx.final(digest.bytes.data());
+            digest.size = std::decay_t<decltype(ctx)>::DIGEST_SIZE;
+        }, context);
+        reset();
+    }
+
+    blockchain::enums::HashAlgorithm HashStream::getAlgorithm() const {
+        return algorithm;
+    }
+
+    void HashStream::reset() {
+        switch (algorithm) {
+            case blockchain::enums::HashAlgorithm::SHA256:
+                context.emplace<SHA256>();
+                break;
+            case blockchain::enums::HashAlgorithm::SHA384:
+                context.emplace<SHA384>();
+                break;
+            case blockchain::enums::HashAlgorithm::SHA512:
+                context.emplace<SHA512>();
+                break;
+        }
+        std::visit([](auto& ctx) { ctx.init(); }, context);
+    }
+} // namespace blockchain::hashing
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <variant>
+#include "Digest.h"
+#include "../enums/HashAlgorithm.h"
+#include "../../../libs/sha2/sha2.h"
+
+namespace blockchain::hashing {
+    /**
+     * @brief An incremental hash over data fed in any number of pieces
+     * Lets large inputs (chain files, exports) be hashed straight from a read buffer or a mapping
+     * instead of being copied into one string first. Lengths are 64-bit, so inputs over 4 GiB are fine.
+     */
+    class HashStream {
+    public:
+        /**
+         * @brief Construct a new Hash Stream object for a hash algorithm
+         *
+         * @param algorithm
+         */
+        explicit HashStream(blockchain::enums::HashAlgorithm algorithm);
+
+        /**
+         * @brief Feed the next piece of the data
+         *
+         * @param data
+         * @param length
+         */
+        void update(const uint8_t* data, size_t length);
+
+        /**
+         * @brief Feed the next piece of the data
+         *
+         * @param data
+         */
+        void update(std::string_view data);
+
+        /**
+         * @brief Finish the hash into caller-owned storage
+         * The stream starts over afterwards, so it can be reused for the next input.
+         *
+         * @param digest
+         */
+        void final(Digest& digest);
+
+        /**
+         * @brief Get the hash algorithm of this stream
+         *
+         * @return
+         */
+        [[nodiscard]] blockchain::enums::HashAlgorithm getAlgorithm() const;
+
+    private:
+        /**
+         * @brief Put the context of the algorithm in its initial state
+         */
+        void reset();
+
+        blockchain::enums::HashAlgorithm algorithm;
+        std::variant<SHA256, SHA384, SHA512> context; /** The context of the algorithm, held inline */
+    };
+} // namespace blockchain::hashing
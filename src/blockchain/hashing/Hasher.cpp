@@ -0,0 +1,90 @@
+#include "Hasher.h"
+#include <fstream>
+#include <stdexcept>
+#include "../../../libs/sha2/sha2.h"
+
+namespace blockchain::hashing {
+    /**
+     * @brief Run a one-shot hash with one of the SHA contexts
+     * Helper method
+     *
+     * @tparam Context Either SHA256, SHA384 or SHA512
+     * @param data
+     * @param length
+     * @param digest
+     */
+    template <typename Context>
+    static void hashWith(const uint8_t* data, size_t length, Digest& digest) {
+        Context ctx;
+        ctx.init();
+        ctx.update(data, length);
+        ctx.final(digest.bytes.data());
+        digest.size = Context::DIGEST_SIZE;
+    }
+
+    Hasher::Hasher(blockchain::enums::HashAlgorithm algorithm) : algorithm(algorithm) {}
+
+    Hasher Hasher::forBlockType(blockchain::enums::BlockType type) {
+        switch (type) {
+            case blockchain::enums::BlockType::SUPPLIER:
+            default: // Default to SHA-256
+                return Hasher(blockchain::enums::HashAlgorithm::SHA256);
+            case blockchain::enums::BlockType::TRANSPORTER:
+                return Hasher(blockchain::enums::HashAlgorithm::SHA384);
+            case blockchain::enums::BlockType::TRANSACTION:
+                return Hasher(blockchain::enums::HashAlgorithm::SHA512);
+        }
+    }
+
+    void Hasher::hash(const uint8_t* data, size_t length, Digest& digest) const {
+        switch (algorithm) {
+            case blockchain::enums::HashAlgorithm::SHA256:
+                hashWith<SHA256>(data, length, digest);
+                break;
+            case blockchain::enums::HashAlgorithm::SHA384:
+                hashWith<SHA384>(data, length, digest);
+                break;
+            case blockchain::enums::HashAlgorithm::SHA512:
+                hashWith<SHA512>(data, length, digest);
+                break;
+        }
+    }
+
+    void Hasher::hash(const std::string& data, Digest& digest) const {
+        hash(reinterpret_cast<const uint8_t*>(data.data()), data.size(), digest);
+    }
+
+    void Hasher::hashFile(const std::string& filePath, Digest& digest) const {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filePath);
+        }
+
+        HashStream hashStream = stream();
+        char buffer[64 * 1024];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+            hashStream.update(reinterpret_cast<const uint8_t*>(buffer), static_cast<size_t>(file.gcount()));
+        }
+        hashStream.final(digest);
+    }
+
+    HashStream Hasher::stream() const {
+        return HashStream(algorithm);
+    }
+
+    size_t Hasher::getDigestSize() const {
+        switch (algorithm) {
+            case blockchain::enums::HashAlgorithm::SHA256:
+            default:
+                return SHA256::DIGEST_SIZE;
+            case blockchain::enums::HashAlgorithm::SHA384:
+                return SHA384::DIGEST_SIZE;
+            case blockchain::enums::HashAlgorithm::SHA512:
+                return SHA512::DIGEST_SIZE;
+        }
+    }
+
+    blockchain::enums::HashAlgorithm Hasher::getAlgorithm() const {
+        return algorithm;
+    }
+} // namespace blockchain::hashing
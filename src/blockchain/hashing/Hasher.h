@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Digest.h"
+#include "HashStream.h"
+#include "../enums/BlockType.h"
+#include "../enums/HashAlgorithm.h"
+
+namespace blockchain::hashing {
+    class Hasher {
+    public:
+        /**
+         * @brief Construct a new Hasher object for a hash algorithm
+         *
+         * @param algorithm
+         */
+        explicit Hasher(blockchain::enums::HashAlgorithm algorithm);
+
+        /**
+         * @brief Get the hasher used by a block type
+         * Supplier blocks use SHA-256, Transporter blocks SHA-384 and Transaction blocks SHA-512.
+         *
+         * @param type
+         * @return
+         */
+        static Hasher forBlockType(blockchain::enums::BlockType type);
+
+        /**
+         * @brief Hash a buffer into caller-owned storage
+         * Writes the binary digest without any heap allocation.
+         *
+         * @param data
+         * @param length
+         * @param digest
+         */
+        void hash(const uint8_t* data, size_t length, Digest& digest) const;
+
+        /**
+         * @brief Hash a string into caller-owned storage
+         *
+         * @param data
+         * @param digest
+         */
+        void hash(const std::string& data, Digest& digest) const;
+
+        /**
+         * @brief Hash the contents of a file through a fixed read buffer
+         * The file is streamed, so its size is not limited by memory.
+         *
+         * @param filePath
+         * @param digest
+         */
+        void hashFile(const std::string& filePath, Digest& digest) const;
+
+        /**
+         * @brief Start an incremental hash with this hasher's algorithm
+         *
+         * @return
+         */
+        [[nodiscard]] HashStream stream() const;
+
+        /**
+         * @brief Get the number of bytes of the digests this hasher produces
+         *
+         * @return
+         */
+        [[nodiscard]] size_t getDigestSize() const;
+
+        /**
+         * @brief Get the hash algorithm of this hasher
+         *
+         * @return
+         */
+        [[nodiscard]] blockchain::enums::HashAlgorithm getAlgorithm() const;
+
+    private:
+        /**
+         * @brief The hash algorithm of this hasher
+         */
+        blockchain::enums::HashAlgorithm algorithm;
+    };
+} // namespace blockchain::hashing
@@ -0,0 +1,280 @@
+#include "MerkleMountainRange.h"
+#include <stdexcept>
+#include <string_view>
+
+namespace blockchain::hashing {
+    namespace {
+        /**
+         * @brief View the bytes of a digest as a leaf of a merkle tree
+         *
+         * @param digest
+         * @return
+         */
+        std::string_view asLeaf(const Digest& digest) {
+            return {reinterpret_cast<const char*>(digest.data()), digest.size};
+        }
+    }
+
+    const Hasher MerkleMountainRange::hasher(blockchain::enums::HashAlgorithm::SHA256);
+
+    MerkleMountainRange::MerkleMountainRange() = default;
+
+    void MerkleMountainRange::append(const Digest& leaf) {
+        if (levels.empty()) {
+            levels.emplace_back();
+        }
+
+        Digest node;
+        MerkleTree::hashLeaf(hasher, asLeaf(leaf), node);
+        levels[0].push_back(node);
+        ++size;
+
+        // Every pair completed on a level completes a node on the level above
+        for (size_t height = 0; levels[height].size() % 2 == 0; ++height) {
+            if (height + 1 == levels.size()) {
+                levels.emplace_back();
+            }
+            const auto& children = levels[height];
+            MerkleTree::hashNode(hasher, children[children.size() - 2], children.back(), node);
+            levels[height + 1].push_back(node);
+        }
+    }
+
+    void MerkleMountainRange::truncate(uint64_t size) {
+        if (size >= this->size) {
+            return;
+        }
+
+        // A prefix of the leaves keeps exactly the complete nodes that only cover leaves of the prefix
+        for (size_t height = 0; height < levels.size(); ++height) {
+            levels[height].resize(static_cast<size_t>(size >> height));
+        }
+        this->size = size;
+    }
+
+    Digest MerkleMountainRange::getRoot() const {
+        return getRoot(size);
+    }
+
+    Digest MerkleMountainRange::getRoot(uint64_t size) const {
+        if (size > this->size) {
+            throw std::out_of_range("The merkle mountain range never held that many leaves.");
+        }
+        if (size == 0) {
+            return Digest();
+        }
+
+        std::vector<Digest> peaks;
+        for (const auto& position : peaksOf(size)) {
+            peaks.push_back(nodeAt(position));
+        }
+        return bag(peaks);
+    }
+
+    MerkleProof MerkleMountainRange::proveInclusion(uint64_t index) const {
+        if (index >= size) {
+            throw std::out_of_range("Merkle mountain range leaf index out of range.");
+        }
+
+        const std::vector<Position> positions = peaksOf(size);
+        std::vector<Digest> peaks;
+        size_t peak = 0;
+        uint64_t start = 0;
+        for (size_t i = 0; i < positions.size(); ++i) {
+            peaks.push_back(nodeAt(positions[i]));
+            if (start <= index && index < start + (uint64_t(1) << positions[i].height)) {
+                peak = i;
+            }
+            start += uint64_t(1) << positions[i].height;
+        }
+
+        MerkleProof proof;
+        proof.leafIndex = static_cast<size_t>(index);
+
+        // Up to the peak holding the leaf
+        uint64_t position = index;
+        for (unsigned int height = 0; height < positions[peak].height; ++height) {
+            proof.steps.push_back({levels[height][static_cast<size_t>(position ^ 1)], (position & 1) == 1});
+            position >>= 1;
+        }
+
+        // Then through the bagging, the peaks on the right are bagged first
+        if (peak + 1 < peaks.size()) {
+            proof.steps.push_back({bag(peaks, peak + 1), false});
+        }
+        for (size_t i = peak; i-- > 0;) {
+            proof.steps.push_back({peaks[i], true});
+        }
+        return proof;
+    }
+
+    MmrConsistencyProof MerkleMountainRange::proveConsistency(uint64_t oldSize) const {
+        if (oldSize == 0 || oldSize > size) {
+            throw std::out_of_range("The merkle mountain range never held that many leaves.");
+        }
+
+        MmrConsistencyProof proof;
+        proof.oldSize = oldSize;
+        proof.newSize = size;
+
+        const std::vector<Position> oldPositions = peaksOf(oldSize);
+        for (const auto& position : oldPositions) {
+            proof.oldPeaks.push_back(nodeAt(position));
+        }
+
+        for (const auto& position : peaksOf(size)) {
+            const uint64_t start = position.index << position.height;
+            const uint64_t end = start + (uint64_t(1) << position.height);
+            if (end <= oldSize) {
+                continue; // Also a peak of the old range
+            }
+
+            if (start < oldSize) {
+                // The peak merged the lowest old peaks, climb from the last one and collect its right siblings
+                Position node = oldPositions.back();
+                for (; node.height < position.height; ++node.height, node.index >>= 1) {
+                    if ((node.index & 1) == 0) {
+                        proof.siblings.push_back(nodeAt({node.height, node.index ^ 1}));
+                    }
+                }
+            } else {
+                proof.newPeaks.push_back(nodeAt(position));
+            }
+        }
+        return proof;
+    }
+
+    bool MerkleMountainRange::verifyInclusion(const Digest& leaf, uint64_t index, uint64_t size, const MerkleProof& proof, const Digest& root) {
+        if (index >= size || proof.leafIndex != index) {
+            return false;
+        }
+
+        const std::vector<Position> positions = peaksOf(size);
+        size_t peak = 0;
+        uint64_t start = 0;
+        for (size_t i = 0; i < positions.size(); ++i) {
+            if (start <= index && index < start + (uint64_t(1) << positions[i].height)) {
+                peak = i;
+            }
+            start += uint64_t(1) << positions[i].height;
+        }
+
+        // The expected side of every sibling, up to the peak and then through the bagging
+        std::vector<bool> sides;
+        for (unsigned int height = 0; height < positions[peak].height; ++height) {
+            sides.push_back(((index >> height) & 1) == 1);
+        }
+        if (peak + 1 < positions.size()) {
+            sides.push_back(false);
+        }
+        sides.insert(sides.end(), peak, true);
+
+        if (proof.steps.size() != sides.size()) {
+            return false;
+        }
+
+        Digest digest;
+        MerkleTree::hashLeaf(hasher, asLeaf(leaf), digest);
+        for (size_t i = 0; i < sides.size(); ++i) {
+            const MerkleProofStep& step = proof.steps[i];
+            if (step.siblingOnLeft != sides[i]) {
+                return false;
+            }
+            if (step.siblingOnLeft) {
+                MerkleTree::hashNode(hasher, step.sibling, digest, digest);
+            } else {
+                MerkleTree::hashNode(hasher, digest, step.sibling, digest);
+            }
+        }
+        return digest == root;
+    }
+
+    bool MerkleMountainRange::verifyConsistency(const MmrConsistencyProof& proof, const Digest& oldRoot, const Digest& newRoot) {
+        if (proof.oldSize == 0 || proof.oldSize > proof.newSize) {
+            return false;
+        }
+
+        const std::vector<Position> oldPositions = peaksOf(proof.oldSize);
+        if (proof.oldPeaks.size() != oldPositions.size() || bag(proof.oldPeaks) != oldRoot) {
+            return false;
+        }
+
+        // Rebuild the new peaks from the old ones, the siblings and the appended peaks
+        std::vector<Digest> newPeaks;
+        size_t nextOld = 0;
+        size_t nextSibling = 0;
+        size_t nextNew = 0;
+        for (const auto& position : peaksOf(proof.newSize)) {
+            const uint64_t start = position.index << position.height;
+            const uint64_t end = start + (uint64_t(1) << position.height);
+
+            if (end <= proof.oldSize) {
+                if (nextOld >= oldPositions.size() || !(oldPositions[nextOld] == position)) {
+                    return false;
+                }
+                newPeaks.push_back(proof.oldPeaks[nextOld++]);
+            } else if (start < proof.oldSize) {
+                // The old peaks left of the last one are its left siblings on the way up
+                size_t left = oldPositions.size() - 1;
+                Position node = oldPositions[left];
+                Digest digest = proof.oldPeaks[left];
+                for (; node.height < position.height; ++node.height, node.index >>= 1) {
+                    if ((node.index & 1) == 1) {
+                        if (left == nextOld || !(oldPositions[left - 1] == Position{node.height, node.index ^ 1})) {
+                            return false;
+                        }
+                        --left;
+                        MerkleTree::hashNode(hasher, proof.oldPeaks[left], digest, digest);
+                    } else {
+                        if (nextSibling >= proof.siblings.size()) {
+                            return false;
+                        }
+                        MerkleTree::hashNode(hasher, digest, proof.siblings[nextSibling++], digest);
+                    }
+                }
+                if (left != nextOld) {
+                    return false;
+                }
+                nextOld = oldPositions.size();
+                newPeaks.push_back(digest);
+            } else {
+                if (nextNew >= proof.newPeaks.size()) {
+                    return false;
+                }
+                newPeaks.push_back(proof.newPeaks[nextNew++]);
+            }
+        }
+
+        return nextOld == oldPositions.size() && nextSibling == proof.siblings.size() && nextNew == proof.newPeaks.size() && bag(newPeaks) == newRoot;
+    }
+
+    uint64_t MerkleMountainRange::getSize() const { return size; }
+
+    std::vector<MerkleMountainRange::Position> MerkleMountainRange::peaksOf(uint64_t size) {
+        std::vector<Position> positions;
+        uint64_t start = 0;
+        for (unsigned int height = 64; height-- > 0;) {
+            if ((size >> height) & 1) {
+                positions.push_back({height, start >> height});
+                start += uint64_t(1) << height;
+            }
+        }
+        return positions;
+    }
+
+    Digest MerkleMountainRange::bag(const std::vector<Digest>& peaks, size_t from) {
+        if (from >= peaks.size()) {
+            return Digest();
+        }
+
+        Digest root = peaks.back();
+        for (size_t i = peaks.size() - 1; i-- > from;) {
+            MerkleTree::hashNode(hasher, peaks[i], root, root);
+        }
+        return root;
+    }
+
+    const Digest& MerkleMountainRange::nodeAt(const Position& position) const {
+        return levels[position.height][static_cast<size_t>(position.index)];
+    }
+} // namespace blockchain::hashing
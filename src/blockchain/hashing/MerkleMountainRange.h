@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Digest.h"
+#include "Hasher.h"
+#include "MerkleTree.h"
+
+namespace blockchain::hashing {
+    /**
+     * @brief Proves that a merkle mountain range grew from an earlier one by appending only
+     */
+    struct MmrConsistencyProof {
+        uint64_t oldSize = 0; /** The number of leaves of the earlier range */
+        uint64_t newSize = 0; /** The number of leaves of the current range */
+        std::vector<Digest> oldPeaks; /** The peaks of the earlier range, the highest first */
+        std::vector<Digest> siblings; /** The right siblings from the lowest old peak up to the new peak holding it */
+        std::vector<Digest> newPeaks; /** The peaks of the current range that only hold appended leaves */
+    };
+
+    /**
+     * @brief An append-only accumulator over a list of digests
+     * The leaves form a row of perfect merkle trees (the peaks) of decreasing height, one per set bit of the
+     * number of leaves, and the root bags the peaks from right to left. Appending only hashes the peaks it merges,
+     * and both the inclusion of a leaf and the consistency of an earlier root take O(log n) hashes to prove.
+     * Leaves and nodes are hashed like in a MerkleTree, always with SHA-256.
+     */
+    class MerkleMountainRange {
+    public:
+        /**
+         * @brief Construct a new empty Merkle Mountain Range object
+         */
+        MerkleMountainRange();
+
+        /**
+         * @brief Append a leaf
+         *
+         * @param leaf
+         */
+        void append(const Digest& leaf);
+
+        /**
+         * @brief Drop the leaves from a position on, so they can be appended again
+         *
+         * @param size The number of leaves to keep
+         */
+        void truncate(uint64_t size);
+
+        /**
+         * @brief Get the root of the range, an empty digest while it has no leaves
+         *
+         * @return
+         */
+        [[nodiscard]] Digest getRoot() const;
+
+        /**
+         * @brief Get the root the range had when it held fewer leaves
+         *
+         * @param size
+         * @return
+         */
+        [[nodiscard]] Digest getRoot(uint64_t size) const;
+
+        /**
+         * @brief Get the proof that a leaf is part of the range
+         *
+         * @param index
+         * @return
+         */
+        [[nodiscard]] MerkleProof proveInclusion(uint64_t index) const;
+
+        /**
+         * @brief Get the proof that the range grew from the one it was at an earlier size
+         *
+         * @param oldSize Between 1 and the current size
+         * @return
+         */
+        [[nodiscard]] MmrConsistencyProof proveConsistency(uint64_t oldSize) const;
+
+        /**
+         * @brief Check that a leaf is part of a range with the given root
+         * The shape of the proof is derived from the position and the size, not taken from the proof.
+         *
+         * @param leaf
+         * @param index
+         * @param size
+         * @param proof
+         * @param root
+         * @return
+         */
+        static bool verifyInclusion(const Digest& leaf, uint64_t index, uint64_t size, const MerkleProof& proof, const Digest& root);
+
+        /**
+         * @brief Check that the range with the new root grew from the one with the old root by appending only
+         *
+         * @param proof
+         * @param oldRoot
+         * @param newRoot
+         * @return
+         */
+        static bool verifyConsistency(const MmrConsistencyProof& proof, const Digest& oldRoot, const Digest& newRoot);
+
+        // getters
+        [[nodiscard]] uint64_t getSize() const;
+
+    private:
+        /**
+         * @brief The position of a node, the index counts the nodes of its height from the left
+         */
+        struct Position {
+            unsigned int height;
+            uint64_t index;
+
+            bool operator==(const Position& other) const { return height == other.height && index == other.index; }
+        };
+
+        /**
+         * @brief Get the positions of the peaks of a range, the highest first
+         *
+         * @param size
+         * @return
+         */
+        static std::vector<Position> peaksOf(uint64_t size);
+
+        /**
+         * @brief Bag peaks into a root from right to left
+         *
+         * @param peaks
+         * @param from The first peak to bag
+         * @return
+         */
+        static Digest bag(const std::vector<Digest>& peaks, size_t from = 0);
+
+        /**
+         * @brief Get the hash of a node
+         *
+         * @param position
+         * @return
+         */
+        [[nodiscard]] const Digest& nodeAt(const Position& position) const;
+
+        static const Hasher hasher;
+        std::vector<std::vector<Digest>> levels; /** The complete nodes of every height, from the leaves up */
+        uint64_t size = 0;
+    };
+} // namespace blockchain::hashing
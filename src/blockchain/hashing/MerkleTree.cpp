@@ -0,0 +1,208 @@
+#include "MerkleTree.h"
+#include <stdexcept>
+
+namespace blockchain::hashing {
+    namespace {
+        const uint8_t LEAF_PREFIX = 0x00;
+        const uint8_t NODE_PREFIX = 0x01;
+
+        /**
+         * @brief Split a string at every occurrence of a separator
+         *
+         * @param value
+         * @param separator
+         * @return
+         */
+        std::vector<std::string> splitAt(const std::string& value, const std::string& separator) {
+            std::vector<std::string> parts;
+            size_t start = 0;
+            size_t end;
+            while ((end = value.find(separator, start)) != std::string::npos) {
+                parts.push_back(value.substr(start, end - start));
+                start = end + separator.size();
+            }
+            parts.push_back(value.substr(start));
+            return parts;
+        }
+    }
+
+    const std::string MerkleTree::FIELD_SEPARATOR = " | ";
+    const std::string MerkleTree::RECORD_SEPARATOR = " || ";
+
+    MerkleTree::MerkleTree(const Hasher& hasher, const std::vector<std::string>& leaves) : hasher(hasher), leaves(leaves) {
+        rebuild();
+    }
+
+    void MerkleTree::assign(const std::vector<std::string>& leaves) {
+        if (leaves.size() != this->leaves.size() || leaves.empty()) {
+            this->leaves = leaves;
+            rebuild();
+            return;
+        }
+
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            if (leaves[i] != this->leaves[i]) {
+                update(i, leaves[i]);
+            }
+        }
+    }
+
+    void MerkleTree::assignRoots(const std::vector<Digest>& roots) {
+        if (roots.empty()) {
+            throw std::invalid_argument("A merkle tree needs at least one root to be built over.");
+        }
+
+        if (roots.size() != levels[0].size() || !leaves.empty()) {
+            leaves.clear();
+            levels.assign(1, roots);
+            rebuildAbove();
+            return;
+        }
+
+        for (size_t i = 0; i < roots.size(); ++i) {
+            if (roots[i] != levels[0][i]) {
+                levels[0][i] = roots[i];
+                rehashPath(i);
+            }
+        }
+    }
+
+    void MerkleTree::update(size_t index, const std::string& leaf) {
+        if (index >= leaves.size()) {
+            throw std::out_of_range("Merkle leaf index out of range.");
+        }
+
+        leaves[index] = leaf;
+        hashLeaf(hasher, leaf, levels[0][index]);
+        rehashPath(index);
+    }
+
+    MerkleProof MerkleTree::prove(size_t index) const {
+        if (index >= levels[0].size()) {
+            throw std::out_of_range("Merkle leaf index out of range.");
+        }
+
+        MerkleProof proof;
+        proof.leafIndex = index;
+        for (size_t level = 0; level + 1 < levels.size(); ++level) {
+            const size_t sibling = index ^ 1;
+            if (sibling < levels[level].size()) {
+                proof.steps.push_back({levels[level][sibling], sibling < index});
+            }
+            index /= 2;
+        }
+        return proof;
+    }
+
+    bool MerkleTree::verify(const Hasher& hasher, std::string_view leaf, const MerkleProof& proof, const Digest& root) {
+        Digest digest;
+        hashLeaf(hasher, leaf, digest);
+        for (const auto& step : proof.steps) {
+            if (step.siblingOnLeft) {
+                hashNode(hasher, step.sibling, digest, digest);
+            } else {
+                hashNode(hasher, digest, step.sibling, digest);
+            }
+        }
+        return digest == root;
+    }
+
+    Digest MerkleTree::computeRoot(const Hasher& hasher, const std::vector<std::string>& leaves) {
+        if (leaves.empty()) {
+            return MerkleTree(hasher).getRoot();
+        }
+
+        std::vector<Digest> nodes(leaves.size());
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            hashLeaf(hasher, leaves[i], nodes[i]);
+        }
+        return computeRoot(hasher, std::move(nodes));
+    }
+
+    Digest MerkleTree::computeRoot(const Hasher& hasher, std::vector<Digest> nodes) {
+        if (nodes.empty()) {
+            throw std::invalid_argument("A merkle tree needs at least one root to be built over.");
+        }
+
+        // Collapse the levels in place, the first half of the buffer holds the level being built
+        for (size_t count = nodes.size(); count > 1; count = (count + 1) / 2) {
+            for (size_t i = 0; i < count / 2; ++i) {
+                hashNode(hasher, nodes[2 * i], nodes[2 * i + 1], nodes[i]);
+            }
+            if (count % 2 == 1) {
+                nodes[count / 2] = nodes[count - 1];
+            }
+        }
+        return nodes[0];
+    }
+
+    std::vector<std::string> MerkleTree::splitFields(const std::string& informationString) {
+        return splitAt(informationString, FIELD_SEPARATOR);
+    }
+
+    std::vector<std::string> MerkleTree::splitRecords(const std::string& informationString) {
+        return splitAt(informationString, RECORD_SEPARATOR);
+    }
+
+    void MerkleTree::hashLeaf(const Hasher& hasher, std::string_view leaf, Digest& digest) {
+        HashStream stream = hasher.stream();
+        stream.update(&LEAF_PREFIX, 1);
+        stream.update(leaf);
+        stream.final(digest);
+    }
+
+    void MerkleTree::hashNode(const Hasher& hasher, const Digest& left, const Digest& right, Digest& digest) {
+        HashStream stream = hasher.stream();
+        stream.update(&NODE_PREFIX, 1);
+        stream.update(left.data(), left.size);
+        stream.update(right.data(), right.size);
+        stream.final(digest);
+    }
+
+    void MerkleTree::rehashPath(size_t index) {
+        for (size_t level = 1; level < levels.size(); ++level) {
+            index /= 2;
+            rehashParent(level, index);
+        }
+    }
+
+    void MerkleTree::rehashParent(size_t level, size_t index) {
+        const std::vector<Digest>& children = levels[level - 1];
+        if (2 * index + 1 < children.size()) {
+            hashNode(hasher, children[2 * index], children[2 * index + 1], levels[level][index]);
+        } else {
+            levels[level][index] = children[2 * index]; // Carried up without a sibling
+        }
+    }
+
+    void MerkleTree::rebuild() {
+        levels.clear();
+        if (leaves.empty()) {
+            // An empty tree has the root of a single empty leaf
+            levels.emplace_back(1);
+            hashLeaf(hasher, "", levels[0][0]);
+            return;
+        }
+
+        levels.emplace_back(leaves.size());
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            hashLeaf(hasher, leaves[i], levels[0][i]);
+        }
+        rebuildAbove();
+    }
+
+    void MerkleTree::rebuildAbove() {
+        levels.resize(1);
+        while (levels.back().size() > 1) {
+            const size_t level = levels.size();
+            levels.emplace_back((levels.back().size() + 1) / 2);
+            for (size_t i = 0; i < levels[level].size(); ++i) {
+                rehashParent(level, i);
+            }
+        }
+    }
+
+    const Digest& MerkleTree::getRoot() const { return levels.back()[0]; }
+    const std::vector<std::string>& MerkleTree::getLeaves() const { return leaves; }
+    size_t MerkleTree::getLeafCount() const { return leaves.size(); }
+} // namespace blockchain::hashing
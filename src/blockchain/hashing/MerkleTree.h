@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Digest.h"
+#include "Hasher.h"
+
+namespace blockchain::hashing {
+    /**
+     * @brief One level of the path from a leaf to the root of a merkle tree
+     */
+    struct MerkleProofStep {
+        Digest sibling; /** The hash of the sibling node on this level */
+        bool siblingOnLeft = false; /** Whether the sibling is the left child of their parent */
+    };
+
+    /**
+     * @brief Proves that a leaf is part of a merkle tree without the other leaves
+     */
+    struct MerkleProof {
+        size_t leafIndex = 0; /** The position of the leaf in the tree */
+        std::vector<MerkleProofStep> steps; /** The siblings from the leaf level up to below the root */
+    };
+
+    /**
+     * @brief A merkle tree over the fields of a block's information
+     * Leaves and internal nodes are hashed with distinct prefixes, so a node can never pass for a leaf.
+     * A node without a sibling is carried up to the next level as it is instead of being paired with itself.
+     * Every level is cached, so changing one leaf only rehashes the path from that leaf to the root.
+     *
+     * A tree can also be built over the roots of other trees, whose proofs then extend the proofs of those trees.
+     */
+    class MerkleTree {
+    public:
+        /**
+         * @brief Construct a new Merkle Tree object
+         *
+         * @param hasher The hasher of the leaves and nodes
+         * @param leaves
+         */
+        MerkleTree(const Hasher& hasher, const std::vector<std::string>& leaves = {});
+
+        /**
+         * @brief Set the leaves of the tree
+         * With as many leaves as before only the paths of the leaves that changed are rehashed,
+         * otherwise the tree is rebuilt.
+         *
+         * @param leaves
+         */
+        void assign(const std::vector<std::string>& leaves);
+
+        /**
+         * @brief Set the bottom level of the tree to the roots of other trees
+         * The roots are taken as they are rather than hashed as leaves. With as many roots as before
+         * only the paths of the roots that changed are rehashed, otherwise the tree is rebuilt.
+         *
+         * @param roots
+         */
+        void assignRoots(const std::vector<Digest>& roots);
+
+        /**
+         * @brief Change one leaf and rehash its path to the root
+         *
+         * @param index
+         * @param leaf
+         */
+        void update(size_t index, const std::string& leaf);
+
+        /**
+         * @brief Get the proof that a leaf is part of the tree
+         *
+         * @param index
+         * @return
+         */
+        [[nodiscard]] MerkleProof prove(size_t index) const;
+
+        /**
+         * @brief Check that a leaf is part of the tree with the given root
+         *
+         * @param hasher The hasher the tree was built with
+         * @param leaf
+         * @param proof
+         * @param root
+         * @return
+         */
+        static bool verify(const Hasher& hasher, std::string_view leaf, const MerkleProof& proof, const Digest& root);
+
+        /**
+         * @brief Compute the root over a list of leaves without caching the tree
+         *
+         * @param hasher
+         * @param leaves
+         * @return
+         */
+        static Digest computeRoot(const Hasher& hasher, const std::vector<std::string>& leaves);
+
+        /**
+         * @brief Compute the root over the roots of other trees without caching the tree
+         *
+         * @param hasher
+         * @param roots
+         * @return
+         */
+        static Digest computeRoot(const Hasher& hasher, std::vector<Digest> roots);
+
+        /**
+         * @brief Split an information string into the fields the tree is built over
+         *
+         * @param informationString Fields separated by " | "
+         * @return
+         */
+        static std::vector<std::string> splitFields(const std::string& informationString);
+
+        /**
+         * @brief Split an information string into the records of a block
+         *
+         * @param informationString Records separated by RECORD_SEPARATOR
+         * @return
+         */
+        static std::vector<std::string> splitRecords(const std::string& informationString);
+
+        static const std::string FIELD_SEPARATOR; /** Separates the fields of a record */
+        static const std::string RECORD_SEPARATOR; /** Separates the records of a block */
+
+        /**
+         * @brief Hash a leaf
+         *
+         * @param hasher
+         * @param leaf
+         * @param digest
+         */
+        static void hashLeaf(const Hasher& hasher, std::string_view leaf, Digest& digest);
+
+        /**
+         * @brief Hash the two children of a node
+         *
+         * @param hasher
+         * @param left
+         * @param right
+         * @param digest
+         */
+        static void hashNode(const Hasher& hasher, const Digest& left, const Digest& right, Digest& digest);
+
+        // getters
+        [[nodiscard]] const Digest& getRoot() const;
+        [[nodiscard]] const std::vector<std::string>& getLeaves() const;
+        [[nodiscard]] size_t getLeafCount() const;
+
+    private:
+        /**
+         * @brief Rehash the path from a node of the bottom level to the root
+         *
+         * @param index
+         */
+        void rehashPath(size_t index);
+
+        /**
+         * @brief Recompute the parent of a node from the level below
+         *
+         * @param level The level of the parent
+         * @param index The position of the parent in its level
+         */
+        void rehashParent(size_t level, size_t index);
+
+        /**
+         * @brief Rebuild every level from the leaves
+         */
+        void rebuild();
+
+        /**
+         * @brief Rebuild every level above the bottom one
+         */
+        void rebuildAbove();
+
+        Hasher hasher;
+        std::vector<std::string> leaves; /** The leaves, kept to tell which ones an assignment changes, empty over roots */
+        std::vector<std::vector<Digest>> levels; /** The node hashes from the leaf level up to the root */
+    };
+} // namespace blockchain::hashing
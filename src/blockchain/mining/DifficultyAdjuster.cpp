@@ -0,0 +1,58 @@
+#include "DifficultyAdjuster.h"
+#include "Target.h"
+#include <algorithm>
+#include <numeric>
+
+namespace blockchain::mining {
+    const std::string DifficultyAdjuster::LIMIT_BITS = "ffff7f20";
+
+    DifficultyAdjuster::DifficultyAdjuster(const std::string& initialBits, const RetargetOptions& options)
+            : initialBits(initialBits), options(options) {
+        if (this->options.interval == 0) {
+            this->options.interval = 1;
+        }
+        if (this->options.targetMiningTime == 0) {
+            this->options.targetMiningTime = 1;
+        }
+        if (this->options.maxAdjustment == 0) {
+            this->options.maxAdjustment = 1;
+        }
+    }
+
+    std::string DifficultyAdjuster::getNextBits(blockchain::enums::BlockType type) const {
+        auto it = histories.find(type);
+        if (it == histories.end() || it->second.count == 0) {
+            return initialBits;
+        }
+
+        // The target only moves at the end of every interval
+        const History& history = it->second;
+        if (history.count % options.interval != 0) {
+            return history.bits;
+        }
+
+        // Mean mining time over the interval, bounded so one adjustment moves at most maxAdjustment times
+        const uint64_t total = std::accumulate(history.miningTimes.begin(), history.miningTimes.end(), uint64_t(0));
+        const uint64_t budget = options.targetMiningTime * history.miningTimes.size();
+        const uint64_t elapsed = std::clamp(total, std::max<uint64_t>(budget / options.maxAdjustment, 1), budget * options.maxAdjustment);
+
+        // Slower than the budget raises the target (easier), faster lowers it (harder)
+        const Target limit = Target::fromBits(LIMIT_BITS);
+        Target next = Target::fromBits(history.bits).scaled(elapsed, budget);
+        if (limit < next) {
+            next = limit;
+        }
+
+        return next.toBits();
+    }
+
+    void DifficultyAdjuster::record(blockchain::enums::BlockType type, const std::string& bits, uint64_t miningTime) {
+        History& history = histories[type];
+        history.count++;
+        history.bits = bits;
+        history.miningTimes.push_back(miningTime);
+        if (history.miningTimes.size() > options.interval) {
+            history.miningTimes.pop_front();
+        }
+    }
+} // namespace blockchain::mining
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include "../enums/BlockType.h"
+
+namespace blockchain::mining {
+    /**
+     * @brief Tunables of the difficulty retargeting
+     */
+    struct RetargetOptions {
+        unsigned int interval = 8; /** The number of blocks of a type between two adjustments of its target */
+        uint64_t targetMiningTime = 1000; /** The mean time to mine a block the adjustments aim for, in milliseconds */
+        uint64_t maxAdjustment = 4; /** The largest factor the target moves by in a single adjustment */
+    };
+
+    /**
+     * @brief Derives the bits of the next block of each block type from the mining times of the blocks before it
+     * Every `interval` blocks of a type, the target of that type is scaled by the mean mining time of those blocks
+     * over the budget. The bits and mining time of each block are recorded in the chain, so replaying the blocks
+     * through a fresh adjuster reproduces every adjustment.
+     */
+    class DifficultyAdjuster {
+    public:
+        /**
+         * @brief The easiest target a block can be mined against, in header bits
+         */
+        static const std::string LIMIT_BITS;
+
+        /**
+         * @brief Construct a new Difficulty Adjuster object
+         *
+         * @param initialBits The bits of the first block of every type
+         * @param options
+         */
+        explicit DifficultyAdjuster(const std::string& initialBits, const RetargetOptions& options = RetargetOptions());
+
+        /**
+         * @brief Get the bits the next block of a type has to be mined with
+         *
+         * @param type
+         * @return
+         */
+        [[nodiscard]] std::string getNextBits(blockchain::enums::BlockType type) const;
+
+        /**
+         * @brief Record a block appended to the chain
+         *
+         * @param type
+         * @param bits The bits the block was mined with
+         * @param miningTime The time it took to mine the block, in milliseconds
+         */
+        void record(blockchain::enums::BlockType type, const std::string& bits, uint64_t miningTime);
+
+    private:
+        /**
+         * @brief The blocks recorded for a block type
+         */
+        struct History {
+            uint64_t count = 0; /** The number of blocks recorded */
+            std::string bits; /** The bits of the last block */
+            std::deque<uint64_t> miningTimes; /** The mining times of the last `interval` blocks */
+        };
+
+        /**
+         * @brief The bits of the first block of every type
+         */
+        std::string initialBits;
+
+        /**
+         * @brief The tunables of the retargeting
+         */
+        RetargetOptions options;
+
+        /**
+         * @brief The history of every block type recorded so far
+         */
+        std::map<blockchain::enums::BlockType, History> histories;
+    };
+} // namespace blockchain::mining
@@ -0,0 +1,140 @@
+#include "MiningCheckpoint.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace blockchain::mining {
+    namespace {
+        thread_local MiningCheckpoint* currentCheckpoint = nullptr;
+        thread_local uint64_t currentKey = 0;
+
+        const std::string JOB = "Job";
+        const std::string TYPE = "Block Type";
+        const std::string INFORMATION = "Information";
+        const std::string TEMPLATE = "Template";
+        const std::string TIMESTAMP = "Timestamp";
+        const std::string COVERED = "Covered";
+
+        /**
+         * @brief Get the value of a "Key: value" line if it has the given key
+         *
+         * @param line
+         * @param key
+         * @return
+         */
+        std::optional<std::string> extractValue(const std::string& line, const std::string& key) {
+            if (line.rfind(key + ": ", 0) != 0) {
+                return std::nullopt;
+            }
+            return line.substr(key.size() + 2);
+        }
+    }
+
+    MiningCheckpoint::MiningCheckpoint(const std::string& filePath) : filePath(filePath) {
+        std::ifstream file(filePath);
+        std::string line;
+
+        // A record is only kept once its job line was read, a truncated record is dropped with its job
+        while (std::getline(file, line)) {
+            try {
+                if (auto value = extractValue(line, JOB)) {
+                    CheckpointRecord record;
+                    record.key = std::stoull(*value);
+                    records.push_back(record);
+                    nextKey = std::max(nextKey, record.key + 1);
+                } else if (records.empty()) {
+                    continue;
+                } else if (auto value = extractValue(line, TYPE)) {
+                    records.back().type = blockchain::enums::BlockTypeUtils::fromString(*value);
+                } else if (auto value = extractValue(line, INFORMATION)) {
+                    records.back().information = *value;
+                } else if (auto value = extractValue(line, TEMPLATE)) {
+                    records.back().templateHash = *value;
+                } else if (auto value = extractValue(line, TIMESTAMP)) {
+                    records.back().timestamp = static_cast<uint32_t>(std::stoul(*value));
+                } else if (auto value = extractValue(line, COVERED)) {
+                    records.back().covered = std::stoull(*value);
+                }
+            } catch (const std::exception&) {
+                // An unreadable progress value only means that job starts over
+            }
+        }
+    }
+
+    uint64_t MiningCheckpoint::add(blockchain::enums::BlockType type, const std::string& information) {
+        std::lock_guard<std::mutex> lock(mutex);
+        CheckpointRecord record;
+        record.key = nextKey++;
+        record.type = type;
+        record.information = information;
+        records.push_back(record);
+        write();
+        return record.key;
+    }
+
+    void MiningCheckpoint::save(const CheckpointRecord& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find_if(records.begin(), records.end(), [&record](const CheckpointRecord& r) { return r.key == record.key; });
+        if (it == records.end()) {
+            return; // Dropped in the meantime
+        }
+
+        *it = record;
+        write();
+    }
+
+    void MiningCheckpoint::remove(uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.erase(std::remove_if(records.begin(), records.end(), [key](const CheckpointRecord& r) { return r.key == key; }), records.end());
+        write();
+    }
+
+    std::optional<CheckpointRecord> MiningCheckpoint::find(uint64_t key) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find_if(records.begin(), records.end(), [key](const CheckpointRecord& r) { return r.key == key; });
+        if (it == records.end()) {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    std::vector<CheckpointRecord> MiningCheckpoint::getRecords() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return records;
+    }
+
+    void MiningCheckpoint::write() const {
+        if (records.empty()) {
+            std::remove(filePath.c_str()); // No sidecar file while nothing is pending
+            return;
+        }
+
+        const std::string temporaryPath = filePath + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::trunc);
+            for (const auto& record : records) {
+                file << JOB << ": " << record.key << std::endl
+                     << TYPE << ": " << blockchain::enums::BlockTypeUtils::toString(record.type) << std::endl
+                     << INFORMATION << ": " << record.information << std::endl
+                     << TEMPLATE << ": " << record.templateHash << std::endl
+                     << TIMESTAMP << ": " << record.timestamp << std::endl
+                     << COVERED << ": " << record.covered << std::endl
+                     << std::endl;
+            }
+        }
+        std::rename(temporaryPath.c_str(), filePath.c_str());
+    }
+
+    void MiningCheckpoint::setCurrent(MiningCheckpoint* checkpoint, uint64_t key) {
+        currentCheckpoint = checkpoint;
+        currentKey = key;
+    }
+
+    MiningCheckpoint* MiningCheckpoint::getCurrent() {
+        return currentCheckpoint;
+    }
+
+    uint64_t MiningCheckpoint::getCurrentKey() {
+        return currentKey;
+    }
+} // namespace blockchain::mining
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../enums/BlockType.h"
+
+namespace blockchain::mining {
+    /**
+     * @brief A pending mining job as recorded in the checkpoint file
+     */
+    struct CheckpointRecord {
+        uint64_t key = 0; /** Identifies the job across restarts */
+        blockchain::enums::BlockType type = blockchain::enums::BlockType::SUPPLIER; /** The type of the block being mined */
+        std::string information; /** The information of the block being mined */
+        std::string templateHash; /** The hash of the header prefix being mined, empty until mining starts */
+        uint32_t timestamp = 0; /** The timestamp in the header prefix being mined */
+        uint64_t covered = 0; /** Every search index below it was searched without a solution */
+    };
+
+    /**
+     * @brief The sidecar file recording the mining jobs that have not been recorded in the chain yet
+     * Jobs are recorded when they are queued and dropped once their block is recorded or they are cancelled,
+     * so the jobs of a process that was killed can be queued again on restart and resume where they stopped.
+     */
+    class MiningCheckpoint {
+    public:
+        /**
+         * @brief Construct a new Mining Checkpoint object from the records in its file
+         *
+         * @param filePath
+         */
+        explicit MiningCheckpoint(const std::string& filePath);
+
+        /**
+         * @brief Record a new pending job
+         *
+         * @param type
+         * @param information
+         * @return The key of the job
+         */
+        uint64_t add(blockchain::enums::BlockType type, const std::string& information);
+
+        /**
+         * @brief Update the mining progress of a pending job
+         *
+         * @param record
+         */
+        void save(const CheckpointRecord& record);
+
+        /**
+         * @brief Drop a job whose block was recorded or that was cancelled
+         *
+         * @param key
+         */
+        void remove(uint64_t key);
+
+        /**
+         * @brief Find the record of a pending job
+         *
+         * @param key
+         * @return
+         */
+        [[nodiscard]] std::optional<CheckpointRecord> find(uint64_t key) const;
+
+        /**
+         * @brief Get the records of every pending job, in the order they were queued
+         *
+         * @return
+         */
+        [[nodiscard]] std::vector<CheckpointRecord> getRecords() const;
+
+        /**
+         * @brief Set the job mined on the calling thread, whose progress the miner checkpoints
+         *
+         * @param checkpoint nullptr when the thread mines without checkpoints
+         * @param key
+         */
+        static void setCurrent(MiningCheckpoint* checkpoint, uint64_t key);
+
+        /**
+         * @brief Get the checkpoint of the job mined on the calling thread, if any
+         *
+         * @return
+         */
+        static MiningCheckpoint* getCurrent();
+
+        /**
+         * @brief Get the key of the job mined on the calling thread
+         *
+         * @return
+         */
+        static uint64_t getCurrentKey();
+
+    private:
+        /**
+         * @brief Rewrite the file with the records
+         * Written to a temporary file first, so a kill mid-write leaves the previous checkpoint intact.
+         */
+        void write() const;
+
+        std::string filePath;
+        mutable std::mutex mutex;
+        std::vector<CheckpointRecord> records;
+        uint64_t nextKey = 1;
+    };
+} // namespace blockchain::mining
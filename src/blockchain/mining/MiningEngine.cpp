@@ -0,0 +1,265 @@
+#include "MiningEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace blockchain::mining {
+    namespace {
+        std::mutex defaultOptionsMutex;
+        MiningOptions defaultOptions;
+        thread_local const std::atomic<bool>* cancellation = nullptr;
+
+        /**
+         * @brief A run of chunks owned by one worker.
+         * The j-th chunk of the run is chunk number (j * stride + lane) of the whole nonce space.
+         */
+        struct ChunkRun {
+            std::mutex mutex;
+            uint64_t lane = 0;
+            uint64_t next = 0;
+            uint64_t end = 0;
+            uint64_t searching = std::numeric_limits<uint64_t>::max(); /** The chunk being searched by the owner, if any */
+        };
+
+        /**
+         * @brief Apply the CPU budget of the options to the calling worker thread
+         * Failures are ignored, the worker then simply runs with the defaults of the process.
+         *
+         * @param options
+         * @param worker The index of the worker, picks its CPU from the affinity mask
+         */
+        void applyThreadBudget(const MiningOptions& options, size_t worker) {
+            if (options.affinityMask != 0) {
+                // Deal the CPUs of the mask to the workers in turn
+                std::vector<int> cpus;
+                for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+                    if (options.affinityMask & (1ULL << cpu)) {
+                        cpus.push_back(cpu);
+                    }
+                }
+
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpus[worker % cpus.size()], &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            }
+
+            if (options.niceness != 0) {
+                // On Linux the nice value is per thread, so only the workers are deprioritized
+                const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+                setpriority(PRIO_PROCESS, tid, getpriority(PRIO_PROCESS, tid) + options.niceness);
+            }
+        }
+    }
+
+    MiningEngine::MiningEngine(const MiningOptions& options) : options(options) {
+        if (this->options.chunkSize == 0) {
+            this->options.chunkSize = 1;
+        }
+        this->options.dutyCycle = std::clamp(this->options.dutyCycle, 1U, 100U);
+    }
+
+    unsigned int MiningEngine::getThreadCount() const {
+        // Pinned workers beyond the number of CPUs of the mask would only share their CPU
+        const auto pinnableThreads = static_cast<unsigned int>(std::bitset<64>(options.affinityMask).count());
+        if (options.threads > 0) {
+            return pinnableThreads > 0 ? std::min(options.threads, pinnableThreads) : options.threads;
+        }
+        if (pinnableThreads > 0) {
+            return pinnableThreads;
+        }
+
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 0 ? hardwareThreads : 1;
+    }
+
+    std::optional<uint64_t> MiningEngine::search(uint64_t begin, uint64_t end, const ChunkSearch& searchChunk, const Checkpoint& onCheckpoint) const {
+        if (begin >= end) {
+            return std::nullopt;
+        }
+
+        const uint64_t chunkSize = options.chunkSize;
+        const uint64_t chunkCount = (end - begin - 1) / chunkSize + 1;
+        const uint64_t stride = std::min<uint64_t>(getThreadCount(), chunkCount);
+
+        // Deal the chunks round-robin: worker w owns chunks w, w + stride, w + 2 * stride, ...
+        std::vector<std::unique_ptr<ChunkRun>> runs;
+        for (uint64_t w = 0; w < stride; ++w) {
+            auto run = std::make_unique<ChunkRun>();
+            run->lane = w;
+            run->end = (chunkCount - w + stride - 1) / stride;
+            runs.push_back(std::move(run));
+        }
+
+        // The lowest valid nonce found so far, chunks starting at or above it are not worth searching
+        std::atomic<uint64_t> best{std::numeric_limits<uint64_t>::max()};
+
+        // The workers run on their own threads, so they check the flag of the calling thread
+        const std::atomic<bool>* cancelled = cancellation;
+
+        // Every nonce below the lowest chunk still pending or being searched is covered
+        auto covered = [&] {
+            std::vector<std::unique_lock<std::mutex>> locks;
+            for (auto& run : runs) {
+                locks.emplace_back(run->mutex); // Locked together, so no chunk is stolen past the snapshot
+            }
+
+            uint64_t lowest = std::numeric_limits<uint64_t>::max();
+            for (auto& run : runs) {
+                lowest = std::min(lowest, run->searching);
+                if (run->next < run->end) {
+                    lowest = std::min(lowest, run->next * stride + run->lane);
+                }
+            }
+
+            uint64_t frontier = lowest == std::numeric_limits<uint64_t>::max() ? end : begin + lowest * chunkSize;
+            return std::min(frontier, best.load()); // A solution found below the frontier has to be found again on resume
+        };
+
+        const auto checkpointInterval = std::chrono::milliseconds(options.checkpointInterval);
+        std::atomic<std::chrono::steady_clock::rep> nextCheckpoint{(std::chrono::steady_clock::now() + checkpointInterval).time_since_epoch().count()};
+
+        auto worker = [&](size_t self) {
+            ChunkRun& own = *runs[self];
+
+            while (true) {
+                if (cancelled != nullptr && cancelled->load(std::memory_order_relaxed)) {
+                    return;
+                }
+
+                uint64_t chunk = 0;
+                bool claimed = false;
+
+                {
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    if (own.next < own.end) {
+                        chunk = own.next * stride + own.lane;
+                        ++own.next;
+                        own.searching = chunk;
+                        claimed = true;
+                    }
+                }
+
+                if (!claimed) {
+                    // Steal the upper half of the largest run left on any other worker
+                    ChunkRun* victim = nullptr;
+                    uint64_t largest = 1;
+                    for (size_t w = 0; w < runs.size(); ++w) {
+                        if (w == self) {
+                            continue;
+                        }
+                        std::lock_guard<std::mutex> lock(runs[w]->mutex);
+                        if (runs[w]->end - runs[w]->next > largest) {
+                            largest = runs[w]->end - runs[w]->next;
+                            victim = runs[w].get();
+                        }
+                    }
+
+                    if (victim == nullptr) {
+                        return; // Nothing left that is worth splitting
+                    }
+
+                    std::scoped_lock lock(victim->mutex, own.mutex);
+                    if (victim->end - victim->next < 2) {
+                        continue; // The victim caught up in the meantime, look again
+                    }
+                    uint64_t middle = victim->next + (victim->end - victim->next) / 2;
+                    own.lane = victim->lane;
+                    own.next = middle;
+                    own.end = victim->end;
+                    victim->end = middle;
+                    continue;
+                }
+
+                uint64_t chunkBegin = begin + chunk * chunkSize;
+                if (chunkBegin >= best.load(std::memory_order_relaxed)) {
+                    // The rest of this run lies even higher, drop it and help the others instead
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    own.next = own.end;
+                    own.searching = std::numeric_limits<uint64_t>::max();
+                    continue;
+                }
+
+                uint64_t chunkEnd = chunkBegin + std::min(chunkSize, end - chunkBegin);
+                uint64_t found = 0;
+                auto chunkStart = std::chrono::steady_clock::now();
+                if (searchChunk(chunkBegin, chunkEnd, found)) {
+                    uint64_t current = best.load();
+                    while (found < current && !best.compare_exchange_weak(current, found)) {
+                        // Retry until the lowest nonce wins
+                    }
+                }
+                {
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    own.searching = std::numeric_limits<uint64_t>::max();
+                }
+
+                if (onCheckpoint && options.checkpointInterval > 0) {
+                    // The first worker past the due time takes the checkpoint, the others carry on
+                    auto now = std::chrono::steady_clock::now();
+                    auto due = nextCheckpoint.load();
+                    if (now.time_since_epoch().count() >= due && nextCheckpoint.compare_exchange_strong(due, (now + checkpointInterval).time_since_epoch().count())) {
+                        onCheckpoint(covered());
+                    }
+                }
+
+                if (options.dutyCycle < 100) {
+                    // Idle in proportion to the time spent hashing, so the worker stays within its share of the CPU
+                    auto busy = std::chrono::steady_clock::now() - chunkStart;
+                    std::this_thread::sleep_for(busy * (100 - options.dutyCycle) / options.dutyCycle);
+                }
+            }
+        };
+
+        if (runs.size() == 1 && !options.isThreadBudgeted()) {
+            worker(0); // No point in spawning a thread for a single worker
+        } else {
+            std::vector<std::thread> threads;
+            for (size_t w = 0; w < runs.size(); ++w) {
+                threads.emplace_back([&, w] {
+                    applyThreadBudget(options, w);
+                    worker(w);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        uint64_t result = best.load();
+        if (result == std::numeric_limits<uint64_t>::max() || (cancelled != nullptr && cancelled->load())) {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    MiningOptions MiningEngine::getDefaultOptions() {
+        std::lock_guard<std::mutex> lock(defaultOptionsMutex);
+        return defaultOptions;
+    }
+
+    void MiningEngine::setDefaultOptions(const MiningOptions& options) {
+        std::lock_guard<std::mutex> lock(defaultOptionsMutex);
+        defaultOptions = options;
+    }
+
+    void MiningEngine::setCancellation(const std::atomic<bool>* cancelled) {
+        cancellation = cancelled;
+    }
+
+    bool MiningEngine::isCancelled() {
+        return cancellation != nullptr && cancellation->load();
+    }
+} // namespace blockchain::mining
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace blockchain::mining {
+    /**
+     * @brief Tunables of the parallel nonce search
+     * The threads, duty cycle, niceness and affinity form the CPU budget of the search, so the interactive
+     * prompts and the persistence of the application stay responsive while mining uses the spare capacity.
+     */
+    struct MiningOptions {
+        unsigned int threads = 0; /** The maximum number of worker threads, 0 uses every hardware thread (or every CPU of the affinity mask) */
+        uint64_t chunkSize = 4096; /** The number of nonces a worker claims at a time */
+        unsigned int progressInterval = 500; /** The milliseconds between two progress reports, 0 disables them */
+        unsigned int dutyCycle = 100; /** The percentage of time a worker spends hashing, it sleeps for the rest after each chunk */
+        int niceness = 0; /** The nice value added to the worker threads, higher yields the CPU to the foreground sooner */
+        uint64_t affinityMask = 0; /** The CPUs the worker threads are pinned to one by one, bit n for CPU n, 0 leaves them unpinned */
+        unsigned int checkpointInterval = 0; /** The milliseconds between two checkpoints of a search, 0 disables them */
+
+        /**
+         * @brief Check whether the workers run with a lowered priority or pinned to CPUs
+         * Such workers always get threads of their own, the calling thread is left as it is.
+         *
+         * @return
+         */
+        [[nodiscard]] bool isThreadBudgeted() const { return niceness != 0 || affinityMask != 0; }
+    };
+
+    class MiningEngine {
+    public:
+        /**
+         * @brief Search a chunk of nonces [begin, end) in ascending order.
+         * Returns true and sets found to the first valid nonce of the chunk. Called concurrently by the workers.
+         */
+        using ChunkSearch = std::function<bool(uint64_t begin, uint64_t end, uint64_t& found)>;
+
+        /**
+         * @brief Receive a checkpoint of a search: every nonce below covered was searched without a solution.
+         * Called from one of the workers, at most once per checkpoint interval.
+         */
+        using Checkpoint = std::function<void(uint64_t covered)>;
+
+        /**
+         * @brief Construct a new Mining Engine object
+         *
+         * @param options
+         */
+        explicit MiningEngine(const MiningOptions& options = getDefaultOptions());
+
+        /**
+         * @brief Search the nonce space [begin, end) across the worker threads.
+         * Chunks are dealt round-robin so every worker stays close to the low end of the space,
+         * and a worker that runs out of chunks steals the upper half of the busiest worker's.
+         * Always yields the lowest valid nonce, exactly like a single-threaded ascending search would.
+         *
+         * @param begin
+         * @param end
+         * @param searchChunk
+         * @param onCheckpoint Notified of the progress of the search every checkpoint interval, may be empty
+         * @return The lowest valid nonce, or nothing if the space was exhausted
+         */
+        std::optional<uint64_t> search(uint64_t begin, uint64_t end, const ChunkSearch& searchChunk, const Checkpoint& onCheckpoint = nullptr) const;
+
+        /**
+         * @brief Get the number of worker threads the engine will run.
+         *
+         * @return
+         */
+        [[nodiscard]] unsigned int getThreadCount() const;
+
+        /**
+         * @brief Get the options used by engines constructed without explicit options.
+         *
+         * @return
+         */
+        static MiningOptions getDefaultOptions();
+
+        /**
+         * @brief Set the options used by engines constructed without explicit options.
+         *
+         * @param options
+         */
+        static void setDefaultOptions(const MiningOptions& options);
+
+        /**
+         * @brief Set the flag that cancels the searches started from the calling thread.
+         * The workers check it before every chunk, a cancelled search returns nothing.
+         *
+         * @param cancelled nullptr when the thread has nothing to cancel
+         */
+        static void setCancellation(const std::atomic<bool>* cancelled);
+
+        /**
+         * @brief Check whether the searches started from the calling thread were cancelled.
+         *
+         * @return
+         */
+        static bool isCancelled();
+
+    private:
+        /**
+         * @brief The options of the engine
+         */
+        MiningOptions options;
+    };
+} // namespace blockchain::mining
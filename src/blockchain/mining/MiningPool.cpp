@@ -0,0 +1,413 @@
+#include "MiningPool.h"
+#include "MiningTraits.h"
+#include "NonceSearch.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace blockchain::mining {
+    namespace {
+        constexpr uint32_t POOL_MAGIC = 0x504d5449; // "ITMP"
+        constexpr uint64_t NO_RANGE = std::numeric_limits<uint64_t>::max();
+        constexpr size_t MAX_PREFIX_SIZE = HeaderLayout<blockchain::enums::HashAlgorithm::SHA512>::MAX_SIZE;
+
+        std::atomic<MiningPool*> coordinator{nullptr};
+    }
+
+    /**
+     * @brief The layout of the shared-memory segment of a pool
+     * Everything but the magic is guarded by the process-shared mutex.
+     */
+    struct PoolSegment {
+        /**
+         * @brief An attached worker process and the range it is searching
+         */
+        struct Slot {
+            pid_t pid; /** The worker process, 0 if the slot is free */
+            uint64_t generation; /** The template the range belongs to */
+            uint64_t range; /** The first index of the range being searched, NO_RANGE if none */
+        };
+
+        std::atomic<uint32_t> magic; /** Set once the segment is initialized, cleared when the coordinator leaves */
+        pthread_mutex_t mutex;
+        pid_t coordinator;
+        uint64_t generation; /** Bumped for every published template */
+        bool active; /** Whether ranges of the current template are still handed out */
+        blockchain::enums::HashAlgorithm algorithm;
+        uint8_t prefix[MAX_PREFIX_SIZE];
+        uint32_t prefixLength;
+        uint32_t timestampPosition;
+        uint32_t timestamp;
+        uint32_t compactTarget;
+        uint64_t rangeSize;
+        uint64_t nextIndex; /** The first index of the next range to hand out */
+        uint64_t best; /** The lowest valid index reported so far, NO_RANGE if none */
+        uint64_t attempts; /** Attempts of the workers the coordinator has not counted yet */
+        Slot slots[MiningPool::MAX_WORKERS];
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "The pool magic must be lock-free to be shared between processes");
+
+    namespace {
+        /**
+         * @brief Check whether a process is still running
+         *
+         * @param pid
+         * @return
+         */
+        bool isAlive(pid_t pid) {
+            return pid > 0 && (kill(pid, 0) == 0 || errno != ESRCH);
+        }
+
+        /**
+         * @brief Holds the mutex of a segment, recovering it if its owner died while holding it
+         */
+        class SegmentLock {
+        public:
+            explicit SegmentLock(PoolSegment& segment) : mutex(segment.mutex) {
+                if (pthread_mutex_lock(&mutex) == EOWNERDEAD) {
+                    // The dead owner only ever updates a few fields at once, the ranges it held are reaped by the coordinator
+                    pthread_mutex_consistent(&mutex);
+                }
+            }
+
+            ~SegmentLock() { pthread_mutex_unlock(&mutex); }
+
+            SegmentLock(const SegmentLock&) = delete;
+            SegmentLock& operator=(const SegmentLock&) = delete;
+
+        private:
+            pthread_mutex_t& mutex;
+        };
+
+        /**
+         * @brief Get the end of the range starting at an index
+         *
+         * @param segment
+         * @param range
+         * @return
+         */
+        uint64_t rangeEnd(const PoolSegment& segment, uint64_t range) {
+            return range < NO_RANGE - segment.rangeSize ? range + segment.rangeSize : NO_RANGE;
+        }
+
+        /**
+         * @brief Claim the next range of a template, as long as it lies below the best solution so far
+         *
+         * @param segment
+         * @param generation
+         * @param slot The slot of the worker, -1 for the coordinator
+         * @return The first index of the range
+         */
+        std::optional<uint64_t> claimRange(PoolSegment& segment, uint64_t generation, int slot) {
+            SegmentLock lock(segment);
+            if (segment.generation != generation || !segment.active || segment.nextIndex >= segment.best) {
+                return std::nullopt;
+            }
+
+            uint64_t range = segment.nextIndex;
+            segment.nextIndex = rangeEnd(segment, range);
+            if (slot >= 0) {
+                segment.slots[slot].generation = generation;
+                segment.slots[slot].range = range;
+            }
+            return range;
+        }
+
+        /**
+         * @brief Report the outcome of a searched range
+         *
+         * @param segment
+         * @param generation
+         * @param slot The slot of the worker, -1 for the coordinator
+         * @param found The lowest valid index of the range, if any
+         * @param attempts The attempts to add to the progress of the coordinator
+         */
+        void reportRange(PoolSegment& segment, uint64_t generation, int slot, std::optional<uint64_t> found, uint64_t attempts) {
+            SegmentLock lock(segment);
+            if (slot >= 0) {
+                segment.slots[slot].range = NO_RANGE;
+            }
+            if (segment.generation != generation) {
+                return; // The coordinator moved on, the result belongs to an old template
+            }
+
+            segment.attempts += attempts;
+            if (found && *found < segment.best) {
+                segment.best = *found;
+            }
+        }
+
+        /**
+         * @brief Map the segment of a pool whose coordinator is running
+         *
+         * @param name
+         * @return The segment, or null if there is no initialized segment
+         */
+        PoolSegment* attach(const std::string& name) {
+            int fd = shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd < 0) {
+                return nullptr;
+            }
+
+            void* memory = mmap(nullptr, sizeof(PoolSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (memory == MAP_FAILED) {
+                return nullptr;
+            }
+
+            auto* segment = static_cast<PoolSegment*>(memory);
+            if (segment->magic.load() != POOL_MAGIC || !isAlive(segment->coordinator)) {
+                munmap(memory, sizeof(PoolSegment));
+                return nullptr;
+            }
+            return segment;
+        }
+    }
+
+    MiningPool::MiningPool(const std::string& name, uint64_t rangeSize) : name(name), segment(nullptr) {
+        // Only one coordinator owns a segment, a leftover one is replaced if its coordinator is gone
+        if (PoolSegment* existing = attach(name)) {
+            munmap(existing, sizeof(PoolSegment));
+            throw std::runtime_error("Another process already coordinates the mining pool " + name + ".");
+        }
+        shm_unlink(name.c_str());
+
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to create the mining pool " + name + ": " + std::strerror(errno));
+        }
+        if (ftruncate(fd, sizeof(PoolSegment)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("Unable to size the mining pool " + name + ": " + std::strerror(errno));
+        }
+
+        void* memory = mmap(nullptr, sizeof(PoolSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            throw std::runtime_error("Unable to map the mining pool " + name + ": " + std::strerror(errno));
+        }
+
+        // The fresh segment is zero-filled, the fields that are not zero by default are set here
+        segment = new (memory) PoolSegment();
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&segment->mutex, &attributes);
+        pthread_mutexattr_destroy(&attributes);
+
+        segment->coordinator = getpid();
+        segment->rangeSize = rangeSize > 0 ? rangeSize : 1;
+        segment->best = NO_RANGE;
+        for (auto& slot : segment->slots) {
+            slot.range = NO_RANGE;
+        }
+        segment->magic.store(POOL_MAGIC);
+    }
+
+    MiningPool::~MiningPool() {
+        if (getCoordinator() == this) {
+            setCoordinator(nullptr);
+        }
+
+        {
+            SegmentLock lock(*segment);
+            segment->active = false;
+        }
+        segment->magic.store(0);
+        shm_unlink(name.c_str());
+        munmap(segment, sizeof(PoolSegment));
+    }
+
+    std::optional<uint64_t> MiningPool::mine(blockchain::enums::HashAlgorithm algorithm, const uint8_t* headerPrefix, size_t prefixLength, size_t timestampPosition, uint32_t timestamp, const Target& target, ProgressReporter& progress, uint64_t begin) {
+        if (prefixLength > MAX_PREFIX_SIZE) {
+            throw std::runtime_error("Invalid block header.");
+        }
+
+        // Publish the template, the ranges of the previous one are dropped with its generation
+        uint64_t generation;
+        {
+            SegmentLock lock(*segment);
+            generation = ++segment->generation;
+            segment->algorithm = algorithm;
+            std::memcpy(segment->prefix, headerPrefix, prefixLength);
+            segment->prefixLength = static_cast<uint32_t>(prefixLength);
+            segment->timestampPosition = static_cast<uint32_t>(timestampPosition);
+            segment->timestamp = timestamp;
+            segment->compactTarget = target.toCompact();
+            segment->nextIndex = begin;
+            segment->best = NO_RANGE;
+            segment->attempts = 0;
+            segment->active = true;
+        }
+
+        // The coordinator searches ranges like any worker, the ranges of dead workers are searched again here
+        MiningEngine engine;
+        MiningEngine::ChunkSearch searchChunk = makeChunkSearch(algorithm, headerPrefix, prefixLength, timestampPosition, timestamp, target, progress);
+        std::vector<uint64_t> orphans;
+
+        while (!MiningEngine::isCancelled()) {
+            std::optional<uint64_t> range;
+            if (!orphans.empty()) {
+                range = orphans.back();
+                orphans.pop_back();
+            } else {
+                range = claimRange(*segment, generation, -1);
+            }
+
+            if (range) {
+                reportRange(*segment, generation, -1, engine.search(*range, rangeEnd(*segment, *range), searchChunk), 0);
+                continue;
+            }
+
+            // Nothing is left to claim below the best solution, wait for the workers still searching below it
+            bool pending = false;
+            {
+                SegmentLock lock(*segment);
+                progress.addAttempts(segment->attempts);
+                segment->attempts = 0;
+
+                for (auto& slot : segment->slots) {
+                    if (slot.pid == 0 || slot.generation != generation || slot.range >= segment->best) {
+                        continue;
+                    }
+                    if (!isAlive(slot.pid)) {
+                        orphans.push_back(slot.range);
+                        slot.pid = 0;
+                        slot.range = NO_RANGE;
+                    }
+                    pending = true;
+                }
+            }
+
+            if (!pending) {
+                break;
+            }
+            if (orphans.empty()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        SegmentLock lock(*segment);
+        segment->active = false;
+        progress.addAttempts(segment->attempts);
+        segment->attempts = 0;
+
+        if (MiningEngine::isCancelled() || segment->best == NO_RANGE) {
+            return std::nullopt;
+        }
+        return segment->best;
+    }
+
+    int MiningPool::runWorker(const std::string& name) {
+        std::cout << "Mining pool worker " << getpid() << " waiting for a coordinator on " << name << "..." << std::endl;
+
+        while (true) {
+            PoolSegment* segment = attach(name);
+            if (segment == nullptr) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                continue;
+            }
+
+            // Take a free slot, or the slot of a worker that died
+            int slot = -1;
+            {
+                SegmentLock lock(*segment);
+                for (unsigned int i = 0; i < MAX_WORKERS && slot < 0; ++i) {
+                    // A dead worker's range of the current template is left for the coordinator to search again
+                    const auto& taken = segment->slots[i];
+                    if (taken.pid == 0 || (!isAlive(taken.pid) && (taken.range == NO_RANGE || taken.generation != segment->generation))) {
+                        segment->slots[i].pid = getpid();
+                        segment->slots[i].range = NO_RANGE;
+                        slot = static_cast<int>(i);
+                    }
+                }
+            }
+
+            if (slot < 0) {
+                std::cout << "The mining pool is full, retrying..." << std::endl;
+                munmap(segment, sizeof(PoolSegment));
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                continue;
+            }
+
+            std::cout << "Attached to the mining pool of process " << segment->coordinator << "." << std::endl;
+
+            const MiningOptions options = MiningEngine::getDefaultOptions();
+            MiningEngine engine(options);
+            uint64_t seen = 0;
+
+            while (segment->magic.load() == POOL_MAGIC && isAlive(segment->coordinator)) {
+                // Copy the template out, the coordinator may publish the next one at any time
+                uint8_t prefix[MAX_PREFIX_SIZE];
+                blockchain::enums::HashAlgorithm algorithm = blockchain::enums::HashAlgorithm::SHA256;
+                size_t prefixLength = 0;
+                size_t timestampPosition = 0;
+                uint32_t timestamp = 0;
+                uint32_t compactTarget = 0;
+                uint64_t generation;
+                {
+                    SegmentLock lock(*segment);
+                    generation = segment->generation;
+                    if (!segment->active || generation == seen) {
+                        generation = 0;
+                    } else {
+                        algorithm = segment->algorithm;
+                        prefixLength = segment->prefixLength;
+                        std::memcpy(prefix, segment->prefix, prefixLength);
+                        timestampPosition = segment->timestampPosition;
+                        timestamp = segment->timestamp;
+                        compactTarget = segment->compactTarget;
+                    }
+                }
+
+                if (generation == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    continue;
+                }
+                seen = generation;
+
+                const Target target = Target::fromCompact(compactTarget);
+                ProgressReporter progress(std::chrono::milliseconds(options.progressInterval), target.getExpectedAttempts());
+                MiningEngine::ChunkSearch searchChunk = makeChunkSearch(algorithm, prefix, prefixLength, timestampPosition, timestamp, target, progress);
+
+                while (std::optional<uint64_t> range = claimRange(*segment, generation, slot)) {
+                    const uint64_t before = progress.getAttempts();
+                    std::optional<uint64_t> found = engine.search(*range, rangeEnd(*segment, *range), searchChunk);
+                    reportRange(*segment, generation, slot, found, progress.getAttempts() - before);
+                }
+                progress.stop();
+            }
+
+            {
+                SegmentLock lock(*segment);
+                segment->slots[slot].pid = 0;
+                segment->slots[slot].range = NO_RANGE;
+            }
+            munmap(segment, sizeof(PoolSegment));
+            std::cout << "The mining pool coordinator went away, waiting for a new one..." << std::endl;
+        }
+    }
+
+    MiningPool* MiningPool::getCoordinator() {
+        return coordinator.load();
+    }
+
+    void MiningPool::setCoordinator(MiningPool* pool) {
+        coordinator.store(pool);
+    }
+} // namespace blockchain::mining
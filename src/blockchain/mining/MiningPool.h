@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "MiningEngine.h"
+#include "ProgressReporter.h"
+#include "Target.h"
+#include "../enums/HashAlgorithm.h"
+
+namespace blockchain::mining {
+    struct PoolSegment;
+
+    /**
+     * @brief A local mining pool shared by several processes through a POSIX shared-memory segment
+     * The coordinator publishes the header prefix of the block being mined and hands out ranges of search
+     * indices in ascending order; the worker processes, and the coordinator itself, search the ranges they
+     * claim with every thread of their MiningEngine and report the solutions back through the segment.
+     * The lowest valid index wins, exactly like the search of a single process would.
+     */
+    class MiningPool {
+    public:
+        /**
+         * @brief The most worker processes that can attach to one pool
+         */
+        static constexpr unsigned int MAX_WORKERS = 32;
+
+        /**
+         * @brief Create the shared-memory segment of a pool and become its coordinator
+         * A segment left behind by a coordinator that died is replaced.
+         *
+         * @param name The name of the segment, starting with a slash
+         * @param rangeSize The number of search indices a process claims at a time
+         */
+        MiningPool(const std::string& name, uint64_t rangeSize);
+
+        /**
+         * @brief Stop the pool and remove its segment, the attached workers wait for a new coordinator
+         */
+        ~MiningPool();
+
+        MiningPool(const MiningPool&) = delete;
+        MiningPool& operator=(const MiningPool&) = delete;
+
+        /**
+         * @brief Mine a serialized header prefix together with the attached workers
+         *
+         * @param algorithm
+         * @param headerPrefix
+         * @param prefixLength
+         * @param timestampPosition The offset of the 32-bit timestamp in the prefix
+         * @param timestamp
+         * @param target
+         * @param progress Counts the attempts of the coordinator and the workers
+         * @param begin The first search index, the ones below it are known to be searched
+         * @return The lowest valid search index, nothing if mining was cancelled
+         */
+        std::optional<uint64_t> mine(blockchain::enums::HashAlgorithm algorithm, const uint8_t* headerPrefix, size_t prefixLength, size_t timestampPosition, uint32_t timestamp, const Target& target, ProgressReporter& progress, uint64_t begin = 0);
+
+        /**
+         * @brief Run a worker process of a pool until the process is terminated
+         * Waits for a coordinator to create the segment, and attaches again whenever the coordinator goes away.
+         *
+         * @param name The name of the segment, starting with a slash
+         * @return The exit code of the process
+         */
+        static int runWorker(const std::string& name);
+
+        /**
+         * @brief Get the pool new blocks are mined with, if this process coordinates one
+         *
+         * @return
+         */
+        static MiningPool* getCoordinator();
+
+        /**
+         * @brief Mine new blocks with a pool, or with the local MiningEngine alone if null
+         *
+         * @param pool
+         */
+        static void setCoordinator(MiningPool* pool);
+
+    private:
+        std::string name;
+        PoolSegment* segment;
+    };
+} // namespace blockchain::mining
@@ -0,0 +1,115 @@
+#include "MiningService.h"
+#include "MiningEngine.h"
+#include <algorithm>
+
+namespace blockchain::mining {
+    MiningService::MiningService() : dispatcher(&MiningService::run, this) {}
+
+    MiningService::~MiningService() {
+        shutdown();
+    }
+
+    MiningJobHandle MiningService::submit(const std::string& description, blockchain::enums::MiningPriority priority, Job job, CancelHook onCancel) {
+        auto entry = std::make_unique<Entry>();
+        entry->description = description;
+        entry->priority = priority;
+        entry->job = std::move(job);
+        entry->onCancel = std::move(onCancel);
+        std::shared_future<bool> result = entry->promise.get_future().share();
+
+        uint64_t id;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            id = entry->id = nextId++;
+            queue.push_back(std::move(entry));
+        }
+        changed.notify_all();
+
+        return MiningJobHandle{id, result};
+    }
+
+    bool MiningService::cancel(uint64_t id) {
+        std::unique_ptr<Entry> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (running && running->id == id) {
+                running->cancelled->store(true);
+                return true;
+            }
+
+            auto it = std::find_if(queue.begin(), queue.end(), [id](const std::unique_ptr<Entry>& entry) {
+                return entry->id == id;
+            });
+            if (it == queue.end()) {
+                return false;
+            }
+            dropped = std::move(*it);
+            queue.erase(it);
+        }
+
+        dropped->promise.set_value(false);
+
+        // Outside the lock, the hook may take time or submit another job
+        if (dropped->onCancel) {
+            dropped->onCancel();
+        }
+        return true;
+    }
+
+    std::vector<MiningJobStatus> MiningService::getJobs() const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::vector<MiningJobStatus> jobs;
+        if (running) {
+            jobs.push_back({running->id, running->description, running->priority, true});
+        }
+        for (const auto& entry : queue) {
+            jobs.push_back({entry->id, entry->description, entry->priority, false});
+        }
+        return jobs;
+    }
+
+    void MiningService::shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+
+        if (dispatcher.joinable()) {
+            dispatcher.join();
+        }
+    }
+
+    void MiningService::run() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return; // Stopping and nothing left to finish
+                }
+
+                // Highest priority first, the earliest submitted among equals
+                auto next = std::min_element(queue.begin(), queue.end(), [](const std::unique_ptr<Entry>& a, const std::unique_ptr<Entry>& b) {
+                    return a->priority != b->priority ? a->priority > b->priority : a->id < b->id;
+                });
+                running = std::move(*next);
+                queue.erase(next);
+            }
+
+            // The engine stops searching once the flag of the job is raised
+            MiningEngine::setCancellation(running->cancelled.get());
+            try {
+                bool persisted = running->job();
+                running->promise.set_value(persisted);
+            } catch (...) {
+                running->promise.set_exception(std::current_exception());
+            }
+            MiningEngine::setCancellation(nullptr);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            running.reset();
+        }
+    }
+} // namespace blockchain::mining
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../enums/MiningPriority.h"
+
+namespace blockchain::mining {
+    /**
+     * @brief A submitted mining job
+     */
+    struct MiningJobHandle {
+        uint64_t id; /** The id to cancel the job with */
+        std::shared_future<bool> result; /** Whether the job completed and persisted its block, false when cancelled */
+    };
+
+    /**
+     * @brief A snapshot of a job that has not finished yet
+     */
+    struct MiningJobStatus {
+        uint64_t id;
+        std::string description;
+        blockchain::enums::MiningPriority priority;
+        bool running;
+    };
+
+    /**
+     * @brief Runs mining jobs one at a time on a background thread
+     * Jobs run in order of priority, then submission. Each job mines with every worker of the MiningEngine,
+     * so running them one after another keeps the chain tip each job builds on well-defined.
+     */
+    class MiningService {
+    public:
+        /**
+         * @brief The work of a job
+         * Returns whether it persisted its result. Mining inside the job stops early once the job is cancelled.
+         */
+        using Job = std::function<bool()>;
+
+        /**
+         * @brief Run in place of a job that is cancelled while it is still queued
+         * A running job sees its own cancellation, a queued one never runs, so it cleans up through this instead.
+         */
+        using CancelHook = std::function<void()>;
+
+        /**
+         * @brief Construct a new Mining Service object and start its dispatcher thread
+         */
+        MiningService();
+
+        /**
+         * @brief Finish the queued jobs and stop the dispatcher thread
+         */
+        ~MiningService();
+
+        MiningService(const MiningService&) = delete;
+        MiningService& operator=(const MiningService&) = delete;
+
+        /**
+         * @brief Queue a job
+         *
+         * @param description Shown when listing the jobs
+         * @param priority
+         * @param job
+         * @param onCancel Run if the job is cancelled before it starts
+         * @return
+         */
+        MiningJobHandle submit(const std::string& description, blockchain::enums::MiningPriority priority, Job job, CancelHook onCancel = nullptr);
+
+        /**
+         * @brief Cancel a job
+         * A queued job is dropped after running its cancel hook, a running job stops mining and does not persist its block.
+         *
+         * @param id
+         * @return Whether the job was still queued or running
+         */
+        bool cancel(uint64_t id);
+
+        /**
+         * @brief Get the jobs that have not finished yet, the running one first
+         *
+         * @return
+         */
+        [[nodiscard]] std::vector<MiningJobStatus> getJobs() const;
+
+        /**
+         * @brief Wait for every queued job to finish, then stop the dispatcher thread
+         */
+        void shutdown();
+
+    private:
+        /**
+         * @brief A job waiting for or being run by the dispatcher
+         */
+        struct Entry {
+            uint64_t id;
+            std::string description;
+            blockchain::enums::MiningPriority priority;
+            Job job;
+            CancelHook onCancel;
+            std::promise<bool> promise;
+            std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+        };
+
+        /**
+         * @brief The loop of the dispatcher thread
+         */
+        void run();
+
+        mutable std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<std::unique_ptr<Entry>> queue; /** The jobs waiting to run */
+        std::unique_ptr<Entry> running; /** The job being run, if any */
+        uint64_t nextId = 1;
+        bool stopping = false;
+        std::thread dispatcher;
+    };
+} // namespace blockchain::mining
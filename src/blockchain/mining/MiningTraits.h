@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include "../enums/HashAlgorithm.h"
+#include "../hashing/Digest.h"
+#include "../../../libs/sha2/sha2.h"
+#include "../../../libs/sha2/sha256_x8.h"
+#include "../../../libs/sha2/sha512_x4.h"
+
+namespace blockchain::mining {
+    /**
+     * @brief Compile-time description of a hash algorithm used for mining
+     * Specialized per algorithm so the mining loop of each block type is instantiated and inlined separately.
+     *
+     * @tparam Algorithm
+     */
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    struct HashTraits;
+
+    template <>
+    struct HashTraits<blockchain::enums::HashAlgorithm::SHA256> {
+        using Context = SHA256; /** The scalar hash context */
+        using Kernel = SHA256x8; /** The multi-buffer kernel finishing several midstates per call */
+        static constexpr size_t DIGEST_SIZE = SHA256::DIGEST_SIZE;
+
+        /**
+         * @brief Hash one message per lane of the kernel, every message of the same length
+         */
+        static void hashLanes(const unsigned char* const messages[Kernel::LANES], size_t length, unsigned char digests[Kernel::LANES][DIGEST_SIZE]) {
+            Kernel::hash(messages, length, digests);
+        }
+    };
+
+    template <>
+    struct HashTraits<blockchain::enums::HashAlgorithm::SHA384> {
+        using Context = SHA384;
+        using Kernel = SHA512x4; // SHA-384 shares the 64-bit kernel of SHA-512
+        static constexpr size_t DIGEST_SIZE = SHA384::DIGEST_SIZE;
+
+        static void hashLanes(const unsigned char* const messages[Kernel::LANES], size_t length, unsigned char digests[Kernel::LANES][DIGEST_SIZE]) {
+            Kernel::hash384(messages, length, digests);
+        }
+    };
+
+    template <>
+    struct HashTraits<blockchain::enums::HashAlgorithm::SHA512> {
+        using Context = SHA512;
+        using Kernel = SHA512x4;
+        static constexpr size_t DIGEST_SIZE = SHA512::DIGEST_SIZE;
+
+        static void hashLanes(const unsigned char* const messages[Kernel::LANES], size_t length, unsigned char digests[Kernel::LANES][DIGEST_SIZE]) {
+            Kernel::hash512(messages, length, digests);
+        }
+    };
+
+    /**
+     * @brief Byte layout of the serialized block header of a block hashed with the given algorithm
+     * version | previous hash | merkle root | timestamp | bits | nonce
+     * The previous hash belongs to the parent block, whose type (and digest size) may differ,
+     * so the offsets of the fields after it are relative to its end.
+     *
+     * @tparam Algorithm
+     */
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    struct HeaderLayout {
+        static constexpr size_t VERSION_SIZE = 4;
+        static constexpr size_t MERKLE_ROOT_SIZE = HashTraits<Algorithm>::DIGEST_SIZE;
+        static constexpr size_t TIMESTAMP_SIZE = 4;
+        static constexpr size_t BITS_SIZE = 4;
+        static constexpr size_t NONCE_SIZE = 4;
+
+        static constexpr size_t VERSION_OFFSET = 0;
+        static constexpr size_t PREVIOUS_HASH_OFFSET = VERSION_OFFSET + VERSION_SIZE;
+
+        // Relative to the end of the previous hash
+        static constexpr size_t MERKLE_ROOT_OFFSET = 0;
+        static constexpr size_t TIMESTAMP_OFFSET = MERKLE_ROOT_OFFSET + MERKLE_ROOT_SIZE;
+        static constexpr size_t BITS_OFFSET = TIMESTAMP_OFFSET + TIMESTAMP_SIZE;
+        static constexpr size_t NONCE_OFFSET = BITS_OFFSET + BITS_SIZE;
+
+        static constexpr size_t MAX_SIZE = PREVIOUS_HASH_OFFSET + hashing::Digest::MAX_SIZE + NONCE_OFFSET + NONCE_SIZE;
+    };
+} // namespace blockchain::mining
@@ -0,0 +1,15 @@
+#include "NonceSearch.h"
+
+namespace blockchain::mining {
+    MiningEngine::ChunkSearch makeChunkSearch(blockchain::enums::HashAlgorithm algorithm, const uint8_t* headerPrefix, size_t prefixLength, size_t timestampPosition, uint32_t timestamp, const Target& target, ProgressReporter& progress) {
+        switch (algorithm) {
+            case blockchain::enums::HashAlgorithm::SHA256:
+            default:
+                return makeChunkSearch<blockchain::enums::HashAlgorithm::SHA256>(RollingPrefix<blockchain::enums::HashAlgorithm::SHA256>(headerPrefix, prefixLength, timestampPosition, timestamp), target, progress);
+            case blockchain::enums::HashAlgorithm::SHA384:
+                return makeChunkSearch<blockchain::enums::HashAlgorithm::SHA384>(RollingPrefix<blockchain::enums::HashAlgorithm::SHA384>(headerPrefix, prefixLength, timestampPosition, timestamp), target, progress);
+            case blockchain::enums::HashAlgorithm::SHA512:
+                return makeChunkSearch<blockchain::enums::HashAlgorithm::SHA512>(RollingPrefix<blockchain::enums::HashAlgorithm::SHA512>(headerPrefix, prefixLength, timestampPosition, timestamp), target, progress);
+        }
+    }
+} // namespace blockchain::mining
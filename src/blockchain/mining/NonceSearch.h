@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "MiningEngine.h"
+#include "MiningTraits.h"
+#include "ProgressReporter.h"
+#include "Target.h"
+
+namespace blockchain::mining {
+    /**
+     * @brief The constant header prefix of a block being mined, with its timestamp rolled forward on demand
+     * A search index holds the 32-bit header nonce in its low half and the number of seconds the timestamp
+     * is rolled forward in its high half, so exhausting the nonces of one timestamp moves on to the next.
+     *
+     * @tparam Algorithm The hash algorithm of the block type
+     */
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    struct RollingPrefix {
+        using Context = typename HashTraits<Algorithm>::Context;
+
+        std::array<uint8_t, HeaderLayout<Algorithm>::MAX_SIZE> bytes;
+        size_t length;
+        size_t timestampPosition;
+        uint32_t timestamp;
+        Context midstate; /** The midstate of the prefix with the timestamp not rolled */
+
+        RollingPrefix(const uint8_t* headerPrefix, size_t prefixLength, size_t timestampPosition, uint32_t timestamp)
+                : length(prefixLength), timestampPosition(timestampPosition), timestamp(timestamp) {
+            std::memcpy(bytes.data(), headerPrefix, prefixLength);
+            midstate.init();
+            midstate.update(bytes.data(), length);
+        }
+
+        /**
+         * @brief Get the midstate of the prefix with the timestamp rolled forward
+         * Absorbing the prefix again costs a couple of compressions, once per chunk at most.
+         *
+         * @param roll
+         * @return
+         */
+        [[nodiscard]] Context midstateFor(uint32_t roll) const {
+            if (roll == 0) {
+                return midstate;
+            }
+
+            std::array<uint8_t, HeaderLayout<Algorithm>::MAX_SIZE> rolled = bytes;
+            const uint32_t rolledTimestamp = timestamp + roll;
+            for (size_t i = 0; i < HeaderLayout<Algorithm>::TIMESTAMP_SIZE; ++i) {
+                rolled[timestampPosition + i] = static_cast<uint8_t>((rolledTimestamp >> (i * 8)) & 0xFF);
+            }
+
+            Context ctx;
+            ctx.init();
+            ctx.update(rolled.data(), length);
+            return ctx;
+        }
+
+        /**
+         * @brief Get the end of the segment of search indices sharing the timestamp of the given index
+         *
+         * @param index
+         * @param end The end of the chunk
+         * @return
+         */
+        [[nodiscard]] static uint64_t segmentEnd(uint64_t index, uint64_t end) {
+            const uint64_t nextRoll = (index | 0xFFFFFFFFULL) + 1; // Wraps to 0 past the last roll
+            return nextRoll == 0 ? end : std::min(end, nextRoll);
+        }
+    };
+
+    /**
+     * @brief Build the chunk search for a hash context holding the midstate of the header prefix
+     * The prefix is absorbed once, every attempt copies the midstate and only compresses the final block(s) with the nonce.
+     *
+     * @tparam Algorithm The hash algorithm of the block type
+     * @param prefix
+     * @param target
+     * @param progress
+     * @return
+     */
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    MiningEngine::ChunkSearch makeMidstateSearch(const RollingPrefix<Algorithm>& prefix, const Target& target, ProgressReporter& progress) {
+        using Context = typename HashTraits<Algorithm>::Context;
+        using Layout = HeaderLayout<Algorithm>;
+        constexpr size_t digestSize = HashTraits<Algorithm>::DIGEST_SIZE;
+
+        return [prefix, target, &progress](uint64_t begin, uint64_t end, uint64_t& found) {
+            unsigned char digest[digestSize];
+            unsigned char nonceBytes[Layout::NONCE_SIZE];
+
+            for (uint64_t segment = begin; segment < end; segment = RollingPrefix<Algorithm>::segmentEnd(segment, end)) {
+                const Context midstate = prefix.midstateFor(static_cast<uint32_t>(segment >> 32));
+                const uint64_t segmentEnd = RollingPrefix<Algorithm>::segmentEnd(segment, end);
+
+                for (uint64_t candidate = segment; candidate < segmentEnd; ++candidate) {
+                    // Only the low half of the index is the nonce in the header
+                    for (size_t i = 0; i < Layout::NONCE_SIZE; ++i) {
+                        nonceBytes[i] = static_cast<unsigned char>((candidate >> (i * 8)) & 0xFF);
+                    }
+
+                    Context ctx = midstate;
+                    ctx.update(nonceBytes, Layout::NONCE_SIZE);
+                    ctx.final(digest);
+
+                    // Check if the hash meets the target of the block bits
+                    if (target.isMetBy(digest, digestSize)) {
+                        progress.addAttempts(candidate - begin + 1);
+                        found = candidate;
+                        return true;
+                    }
+                }
+            }
+
+            progress.addAttempts(end - begin);
+            return false;
+        };
+    }
+
+    /**
+     * @brief Build the chunk search hashing several nonces per call with a multi-buffer kernel
+     *
+     * @tparam Algorithm The hash algorithm of the block type, selects the kernel SHA256x8 or SHA512x4
+     * @param prefix
+     * @param target
+     * @param progress
+     * @return
+     */
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    MiningEngine::ChunkSearch makeMultiBufferSearch(const RollingPrefix<Algorithm>& prefix, const Target& target, ProgressReporter& progress) {
+        using Context = typename HashTraits<Algorithm>::Context;
+        using Kernel = typename HashTraits<Algorithm>::Kernel;
+        using Layout = HeaderLayout<Algorithm>;
+        constexpr size_t digestSize = HashTraits<Algorithm>::DIGEST_SIZE;
+
+        return [prefix, target, &progress](uint64_t begin, uint64_t end, uint64_t& found) {
+            unsigned char digests[Kernel::LANES][digestSize];
+            unsigned char nonceBytes[Kernel::LANES][Layout::NONCE_SIZE];
+            const unsigned char* suffixes[Kernel::LANES];
+
+            for (unsigned int lane = 0; lane < Kernel::LANES; ++lane) {
+                suffixes[lane] = nonceBytes[lane];
+            }
+
+            for (uint64_t segment = begin; segment < end; segment = RollingPrefix<Algorithm>::segmentEnd(segment, end)) {
+                const Context midstate = prefix.midstateFor(static_cast<uint32_t>(segment >> 32));
+                const uint64_t segmentEnd = RollingPrefix<Algorithm>::segmentEnd(segment, end);
+
+                for (uint64_t batch = segment; batch < segmentEnd; batch += Kernel::LANES) {
+                    // Lanes past the end of the segment repeat its last nonce and are ignored below
+                    for (unsigned int lane = 0; lane < Kernel::LANES; ++lane) {
+                        uint64_t candidate = std::min<uint64_t>(batch + lane, segmentEnd - 1);
+                        for (size_t i = 0; i < Layout::NONCE_SIZE; ++i) {
+                            nonceBytes[lane][i] = static_cast<unsigned char>((candidate >> (i * 8)) & 0xFF);
+                        }
+                    }
+
+                    Kernel::finalFromMidstate(midstate, suffixes, Layout::NONCE_SIZE, digests);
+
+                    // Lanes are checked in ascending nonce order so the lowest valid nonce wins
+                    for (unsigned int lane = 0; lane < Kernel::LANES && batch + lane < segmentEnd; ++lane) {
+                        if (target.isMetBy(digests[lane], digestSize)) {
+                            progress.addAttempts(batch + lane - begin + 1);
+                            found = batch + lane;
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            progress.addAttempts(end - begin);
+            return false;
+        };
+    }
+
+    /**
+     * @brief Build the fastest chunk search the CPU supports for a hash algorithm known at compile time
+     *
+     * @tparam Algorithm
+     * @param prefix
+     * @param target
+     * @param progress
+     * @return
+     */
+    template <blockchain::enums::HashAlgorithm Algorithm>
+    MiningEngine::ChunkSearch makeChunkSearch(const RollingPrefix<Algorithm>& prefix, const Target& target, ProgressReporter& progress) {
+        // Each worker resumes from the midstate of the prefix with the nonce patched in,
+        // several nonces per call where the CPU has the vector units for it
+        return HashTraits<Algorithm>::Kernel::isAccelerated()
+                ? makeMultiBufferSearch<Algorithm>(prefix, target, progress)
+                : makeMidstateSearch<Algorithm>(prefix, target, progress);
+    }
+
+    /**
+     * @brief Build the chunk search for a serialized header prefix whose hash algorithm is only known at runtime
+     * Used where the header arrives as bytes, such as the block templates of the mining pool.
+     *
+     * @param algorithm
+     * @param headerPrefix
+     * @param prefixLength
+     * @param timestampPosition The offset of the 32-bit timestamp in the prefix
+     * @param timestamp
+     * @param target
+     * @param progress
+     * @return
+     */
+    MiningEngine::ChunkSearch makeChunkSearch(blockchain::enums::HashAlgorithm algorithm, const uint8_t* headerPrefix, size_t prefixLength, size_t timestampPosition, uint32_t timestamp, const Target& target, ProgressReporter& progress);
+} // namespace blockchain::mining
@@ -0,0 +1,56 @@
+#include "ProgressReporter.h"
+#include <iomanip>
+
+namespace blockchain::mining {
+    ProgressReporter::ProgressReporter(std::chrono::milliseconds interval, double expectedAttempts, std::ostream& out)
+            : interval(interval), expectedAttempts(expectedAttempts), out(out), start(std::chrono::steady_clock::now()) {
+        if (interval.count() > 0) {
+            thread = std::thread(&ProgressReporter::run, this);
+        }
+    }
+
+    ProgressReporter::~ProgressReporter() {
+        stop();
+    }
+
+    void ProgressReporter::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return;
+            }
+            stopping = true;
+        }
+        stopped.notify_all();
+
+        if (thread.joinable()) {
+            thread.join();
+            out << std::endl;
+        }
+    }
+
+    void ProgressReporter::run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopped.wait_for(lock, interval, [this] { return stopping; })) {
+            report();
+        }
+    }
+
+    void ProgressReporter::report() {
+        const uint64_t count = attempts.load(std::memory_order_relaxed);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double rate = seconds > 0 ? count / seconds : 0;
+
+        out << "Mining... Attempts: " << count
+            << ", Rate: " << std::fixed << std::setprecision(2) << rate / 1e6 << " MH/s"
+            << ", ETA: ";
+
+        // Past the mean the search is just unlucky, every further attempt is as likely to succeed
+        if (rate > 0 && count < expectedAttempts) {
+            out << std::setprecision(1) << (expectedAttempts - count) / rate << " s";
+        } else {
+            out << "any moment";
+        }
+        out << std::defaultfloat << "        \r" << std::flush;
+    }
+} // namespace blockchain::mining
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace blockchain::mining {
+    /**
+     * @brief Reports the progress of a nonce search from its own thread
+     * The miners only add to an atomic attempt counter; the reporter samples it at a fixed interval
+     * and prints the attempts, the hash rate and the expected time left.
+     */
+    class ProgressReporter {
+    public:
+        /**
+         * @brief Construct a new Progress Reporter object and start reporting
+         *
+         * @param interval The time between two reports, 0 disables reporting
+         * @param expectedAttempts The mean number of attempts needed to meet the target
+         * @param out
+         */
+        ProgressReporter(std::chrono::milliseconds interval, double expectedAttempts, std::ostream& out = std::cout);
+
+        /**
+         * @brief Stop reporting
+         */
+        ~ProgressReporter();
+
+        ProgressReporter(const ProgressReporter&) = delete;
+        ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+        /**
+         * @brief Count hashes attempted by a miner
+         *
+         * @param count
+         */
+        void addAttempts(uint64_t count) { attempts.fetch_add(count, std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the number of hashes attempted so far
+         *
+         * @return
+         */
+        [[nodiscard]] uint64_t getAttempts() const { return attempts.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Stop reporting and wait for the reporter thread
+         * Clears the progress line so the next output starts on a clean line.
+         */
+        void stop();
+
+    private:
+        /**
+         * @brief The loop of the reporter thread
+         */
+        void run();
+
+        /**
+         * @brief Print a single progress line
+         */
+        void report();
+
+        std::chrono::milliseconds interval; /** The time between two reports */
+        double expectedAttempts; /** The mean number of attempts needed to meet the target */
+        std::ostream& out; /** The stream the progress is printed to */
+        std::chrono::steady_clock::time_point start; /** When the search started */
+        std::atomic<uint64_t> attempts{0}; /** The number of hashes attempted so far */
+
+        std::mutex mutex;
+        std::condition_variable stopped;
+        bool stopping = false;
+        std::thread thread;
+    };
+} // namespace blockchain::mining
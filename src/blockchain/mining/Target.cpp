@@ -0,0 +1,183 @@
+#include "Target.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace blockchain::mining {
+    /**
+     * @brief Load a big-endian 64-bit word
+     * Helper method
+     *
+     * @param bytes
+     * @return
+     */
+    static uint64_t loadWord(const uint8_t* bytes) {
+        uint64_t word = 0;
+        for (int i = 0; i < 8; ++i) {
+            word = (word << 8) | bytes[i];
+        }
+        return word;
+    }
+
+    Target Target::fromCompact(uint32_t compact) {
+        const int size = static_cast<int>(compact >> 24);
+        const uint32_t mantissa = compact & 0x007FFFFF;
+
+        // Negative targets cannot be met by any hash
+        if (mantissa != 0 && (compact & 0x00800000) != 0) {
+            throw std::runtime_error("Invalid bits.");
+        }
+
+        // Place the three mantissa bytes so the most significant lands `size` bytes from the end
+        uint8_t bytes[32] = {};
+        for (int i = 0; i < 3; ++i) {
+            const int position = 32 - size + i;
+            const auto byte = static_cast<uint8_t>(mantissa >> ((2 - i) * 8));
+            if (position < 0) {
+                if (byte != 0) {
+                    throw std::runtime_error("Invalid bits."); // Wider than 256 bits
+                }
+            } else if (position < 32) {
+                bytes[position] = byte;
+            }
+        }
+
+        Target target;
+        for (size_t i = 0; i < target.words.size(); ++i) {
+            target.words[i] = loadWord(bytes + i * 8);
+        }
+        return target;
+    }
+
+    Target Target::fromBits(const std::string& bits) {
+        const hashing::Digest bytes = hashing::Digest::fromHex(bits);
+        if (bytes.size != 4) {
+            throw std::runtime_error("Invalid bits.");
+        }
+
+        uint32_t compact = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            compact |= static_cast<uint32_t>(bytes.bytes[i]) << (i * 8);
+        }
+        return fromCompact(compact);
+    }
+
+    uint32_t Target::toCompact() const {
+        uint8_t bytes[32];
+        for (size_t i = 0; i < 32; ++i) {
+            bytes[i] = static_cast<uint8_t>(words[i / 8] >> ((7 - i % 8) * 8));
+        }
+
+        // The size is the number of significant bytes
+        int first = 0;
+        while (first < 32 && bytes[first] == 0) {
+            ++first;
+        }
+        if (first == 32) {
+            return 0;
+        }
+
+        uint32_t size = 32 - first;
+        uint32_t mantissa = 0;
+        for (int i = 0; i < 3; ++i) {
+            const int position = first + i;
+            mantissa = (mantissa << 8) | (position < 32 ? bytes[position] : 0);
+        }
+
+        // The top mantissa bit is a sign bit, shift it out to keep the target positive
+        if (mantissa & 0x00800000) {
+            mantissa >>= 8;
+            ++size;
+        }
+
+        return (size << 24) | mantissa;
+    }
+
+    std::string Target::toBits() const {
+        const uint32_t compact = toCompact();
+
+        hashing::Digest bytes;
+        bytes.size = 4;
+        for (size_t i = 0; i < 4; ++i) {
+            bytes.bytes[i] = static_cast<uint8_t>(compact >> (i * 8));
+        }
+        return bytes.toHex();
+    }
+
+    Target Target::scaled(uint64_t numerator, uint64_t denominator) const {
+        // Multiply into five words, least significant first
+        uint64_t product[5] = {};
+        unsigned __int128 carry = 0;
+        for (size_t i = 0; i < words.size(); ++i) {
+            carry += static_cast<unsigned __int128>(words[words.size() - 1 - i]) * numerator;
+            product[i] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
+        product[4] = static_cast<uint64_t>(carry);
+
+        // Long division by the denominator, most significant word first
+        unsigned __int128 remainder = 0;
+        for (int i = 4; i >= 0; --i) {
+            remainder = (remainder << 64) | product[i];
+            product[i] = static_cast<uint64_t>(remainder / denominator);
+            remainder %= denominator;
+        }
+
+        Target target;
+        if (product[4] != 0) {
+            target.words.fill(UINT64_MAX);
+            return target;
+        }
+        for (size_t i = 0; i < target.words.size(); ++i) {
+            target.words[i] = product[target.words.size() - 1 - i];
+        }
+        return target;
+    }
+
+    bool Target::isMetBy(const uint8_t* digest, size_t size) const {
+        // Word-wise compare of the most significant 256 bits
+        for (size_t i = 0; i < words.size(); ++i) {
+            const uint64_t word = loadWord(digest + i * 8);
+            if (word != words[i]) {
+                return word < words[i];
+            }
+        }
+
+        // Equal so far, any bit set beyond the target's width makes the hash greater
+        for (size_t i = words.size() * 8; i < size; ++i) {
+            if (digest[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Target::isMetBy(const hashing::Digest& digest) const {
+        return digest.size >= words.size() * 8 && isMetBy(digest.data(), digest.size);
+    }
+
+    double Target::getExpectedAttempts() const {
+        // 2^256 / (target + 1), the chance of a single hash meeting the target is its inverse
+        double value = 1;
+        for (size_t i = 0; i < words.size(); ++i) {
+            value += std::ldexp(static_cast<double>(words[i]), static_cast<int>(64 * (words.size() - 1 - i)));
+        }
+        return std::ldexp(1.0, 256) / value;
+    }
+
+    std::string Target::toHex() const {
+        hashing::Digest digest;
+        digest.size = words.size() * 8;
+        for (size_t i = 0; i < digest.size; ++i) {
+            digest.bytes[i] = static_cast<uint8_t>(words[i / 8] >> ((7 - i % 8) * 8));
+        }
+        return digest.toHex();
+    }
+
+    bool Target::operator<(const Target& other) const {
+        return words < other.words;
+    }
+
+    bool Target::operator==(const Target& other) const {
+        return words == other.words;
+    }
+} // namespace blockchain::mining
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../hashing/Digest.h"
+
+namespace blockchain::mining {
+    /**
+     * @brief The proof-of-work target decoded from the compact bits of a block header
+     * A hash meets the target when, read as a big-endian number, it is not greater than the target.
+     */
+    class Target {
+    public:
+        /**
+         * @brief Decode a compact target
+         * The top byte is the size of the target in bytes, the low three bytes its most significant digits.
+         *
+         * @param compact
+         * @return
+         */
+        static Target fromCompact(uint32_t compact);
+
+        /**
+         * @brief Decode the bits of a block header
+         * The bits are stored as the hexadecimal form of the little-endian bytes written into the header,
+         * e.g. "ffff001f" is the compact target 0x1f00ffff.
+         *
+         * @param bits
+         * @return
+         */
+        static Target fromBits(const std::string& bits);
+
+        /**
+         * @brief Encode the target in compact form
+         * Only the three most significant bytes are kept, so the result may be slightly lower than the target.
+         *
+         * @return
+         */
+        [[nodiscard]] uint32_t toCompact() const;
+
+        /**
+         * @brief Encode the target as block header bits
+         *
+         * @return
+         */
+        [[nodiscard]] std::string toBits() const;
+
+        /**
+         * @brief Scale the target by a ratio
+         * Saturates at the largest 256-bit value.
+         *
+         * @param numerator
+         * @param denominator Must not be 0
+         * @return
+         */
+        [[nodiscard]] Target scaled(uint64_t numerator, uint64_t denominator) const;
+
+        /**
+         * @brief Check whether a digest meets the target
+         * Digests longer than 256 bits are compared against the target scaled to their width.
+         *
+         * @param digest
+         * @param size The digest size in bytes, at least 32
+         * @return
+         */
+        [[nodiscard]] bool isMetBy(const uint8_t* digest, size_t size) const;
+
+        /**
+         * @brief Check whether a digest meets the target
+         *
+         * @param digest
+         * @return
+         */
+        [[nodiscard]] bool isMetBy(const hashing::Digest& digest) const;
+
+        /**
+         * @brief Get the mean number of attempts needed to find a hash meeting the target
+         *
+         * @return
+         */
+        [[nodiscard]] double getExpectedAttempts() const;
+
+        /**
+         * @brief Get the target as a 256-bit big-endian hexadecimal string
+         *
+         * @return
+         */
+        [[nodiscard]] std::string toHex() const;
+
+        bool operator<(const Target& other) const;
+        bool operator==(const Target& other) const;
+
+    private:
+        /**
+         * @brief The 256-bit target as 64-bit words, most significant first
+         */
+        std::array<uint64_t, 4> words{};
+    };
+} // namespace blockchain::mining
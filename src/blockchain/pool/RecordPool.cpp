@@ -0,0 +1,248 @@
+#include "RecordPool.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+
+namespace blockchain::pool {
+    namespace {
+        const std::string TYPE = "Block Type";
+        const std::string ADDED = "Added";
+        const std::string BATCH = "Batch";
+        const std::string INFORMATION = "Information";
+
+        /**
+         * @brief Get the value of a "Key: value" line if it has the given key
+         *
+         * @param line
+         * @param key
+         * @return
+         */
+        std::optional<std::string> extractValue(const std::string& line, const std::string& key) {
+            if (line.rfind(key + ": ", 0) != 0) {
+                return std::nullopt;
+            }
+            return line.substr(key.size() + 2);
+        }
+    }
+
+    RecordPool::RecordPool(const std::string& filePath, const RecordPoolOptions& options, Seal seal, Claimed claimed)
+            : filePath(filePath), options(options), onSeal(std::move(seal)) {
+        if (this->options.maxRecords == 0) {
+            this->options.maxRecords = 1;
+        }
+
+        std::ifstream file(filePath);
+        std::string line;
+        std::optional<blockchain::enums::BlockType> type;
+        PendingRecord record;
+
+        // A record is only kept once its information line was read, a truncated record is dropped
+        while (std::getline(file, line)) {
+            try {
+                if (auto value = extractValue(line, TYPE)) {
+                    type = blockchain::enums::BlockTypeUtils::fromString(*value);
+                    record = PendingRecord();
+                } else if (!type) {
+                    continue;
+                } else if (auto value = extractValue(line, ADDED)) {
+                    record.added = static_cast<time_t>(std::stoll(*value));
+                } else if (auto value = extractValue(line, BATCH)) {
+                    record.batch = std::stoull(*value);
+                } else if (auto value = extractValue(line, INFORMATION)) {
+                    record.information = *value;
+                    pending[*type].push_back(record);
+                    type.reset();
+                }
+            } catch (const std::exception&) {
+                type.reset(); // An unreadable record is dropped with its type
+            }
+        }
+
+        // A batch still marked was being handed over when the last session ended, the mining job it reached keeps it
+        bool marked = false;
+        for (auto& [batchType, records] : pending) {
+            std::map<uint64_t, std::vector<std::string>> batches;
+            for (const auto& pendingRecord : records) {
+                if (pendingRecord.batch != 0) {
+                    batches[pendingRecord.batch].push_back(pendingRecord.information);
+                }
+            }
+
+            for (const auto& [batch, information] : batches) {
+                if (claimed && claimed(batchType, information)) {
+                    records.erase(std::remove_if(records.begin(), records.end(), [batch = batch](const PendingRecord& pendingRecord) { return pendingRecord.batch == batch; }), records.end());
+                }
+            }
+            for (auto& pendingRecord : records) {
+                pendingRecord.batch = 0;
+            }
+            marked = marked || !batches.empty();
+        }
+        if (marked) {
+            write();
+        }
+
+        timer = std::thread(&RecordPool::run, this);
+    }
+
+    RecordPool::~RecordPool() {
+        stop();
+    }
+
+    size_t RecordPool::add(blockchain::enums::BlockType type, const std::string& information) {
+        size_t count;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending[type].push_back({information, std::time(nullptr)});
+            write();
+            count = pending[type].size();
+        }
+        changed.notify_all(); // The record may be the oldest one now
+
+        if (count >= options.maxRecords) {
+            seal(type);
+            std::lock_guard<std::mutex> lock(mutex);
+            count = pending[type].size();
+        }
+        return count;
+    }
+
+    void RecordPool::restore(blockchain::enums::BlockType type, const std::vector<std::string>& records) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const time_t now = std::time(nullptr);
+            // Marked like a batch being handed over, until the mining job that had the records drops their checkpoint
+            const uint64_t batch = nextBatch++;
+            for (const auto& information : records) {
+                pending[type].push_back({information, now, batch});
+            }
+            write();
+        }
+        changed.notify_all();
+    }
+
+    size_t RecordPool::sealAll() {
+        std::vector<blockchain::enums::BlockType> types;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& [type, records] : pending) {
+                types.push_back(type);
+            }
+        }
+
+        size_t sealed = 0;
+        for (auto type : types) {
+            while (seal(type)) {
+                ++sealed;
+            }
+        }
+        return sealed;
+    }
+
+    std::vector<PendingRecord> RecordPool::getPending(blockchain::enums::BlockType type) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = pending.find(type);
+        return it == pending.end() ? std::vector<PendingRecord>() : it->second;
+    }
+
+    void RecordPool::stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+
+        if (timer.joinable()) {
+            timer.join();
+        }
+    }
+
+    bool RecordPool::seal(blockchain::enums::BlockType type) {
+        std::lock_guard<std::mutex> sealLock(sealMutex);
+
+        // Records are only appended outside a seal, so the batch stays at the front of the list
+        std::vector<std::string> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& records = pending[type];
+            const size_t count = std::min(records.size(), options.maxRecords);
+            if (count == 0) {
+                return false;
+            }
+
+            // Marked before it is handed over and dropped after, so a kill in between neither loses nor repeats it
+            const uint64_t id = nextBatch++;
+            for (size_t i = 0; i < count; ++i) {
+                records[i].batch = id;
+                batch.push_back(records[i].information);
+            }
+            write();
+        }
+
+        onSeal(type, batch);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& records = pending[type];
+            records.erase(records.begin(), records.begin() + static_cast<std::ptrdiff_t>(batch.size()));
+            write();
+        }
+        changed.notify_all();
+        return true;
+    }
+
+    void RecordPool::run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            // The type whose oldest record is due first
+            std::optional<std::chrono::system_clock::time_point> due;
+            blockchain::enums::BlockType dueType = blockchain::enums::BlockType::SUPPLIER;
+            for (const auto& [type, records] : pending) {
+                if (records.empty()) {
+                    continue;
+                }
+                auto deadline = std::chrono::system_clock::from_time_t(records.front().added) + options.maxAge;
+                if (!due || deadline < *due) {
+                    due = deadline;
+                    dueType = type;
+                }
+            }
+
+            if (!due) {
+                changed.wait(lock);
+            } else if (std::chrono::system_clock::now() < *due) {
+                changed.wait_until(lock, *due);
+            } else {
+                lock.unlock();
+                seal(dueType);
+                lock.lock();
+            }
+        }
+    }
+
+    void RecordPool::write() const {
+        bool empty = std::all_of(pending.begin(), pending.end(), [](const auto& entry) { return entry.second.empty(); });
+        if (empty) {
+            std::remove(filePath.c_str()); // No sidecar file while nothing is pending
+            return;
+        }
+
+        const std::string temporaryPath = filePath + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::trunc);
+            for (const auto& [type, records] : pending) {
+                for (const auto& record : records) {
+                    file << TYPE << ": " << blockchain::enums::BlockTypeUtils::toString(type) << std::endl
+                         << ADDED << ": " << record.added << std::endl;
+                    if (record.batch != 0) {
+                        file << BATCH << ": " << record.batch << std::endl;
+                    }
+                    file << INFORMATION << ": " << record.information << std::endl
+                         << std::endl;
+                }
+            }
+        }
+        std::rename(temporaryPath.c_str(), filePath.c_str());
+    }
+} // namespace blockchain::pool
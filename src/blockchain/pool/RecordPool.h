@@ -0,0 +1,141 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../enums/BlockType.h"
+
+namespace blockchain::pool {
+    /**
+     * @brief A record waiting in the pool to be sealed into a block
+     */
+    struct PendingRecord {
+        std::string information; /** The information string of the record */
+        time_t added = 0; /** When the record entered the pool, in seconds since the epoch */
+        uint64_t batch = 0; /** The batch the record is being handed over in, 0 while it only waits */
+    };
+
+    /**
+     * @brief The thresholds a pool seals its records at
+     */
+    struct RecordPoolOptions {
+        size_t maxRecords = 64; /** The records of a type are sealed once this many are pending */
+        std::chrono::seconds maxAge{300}; /** The records of a type are sealed once the oldest waited this long */
+    };
+
+    /**
+     * @brief Collects the records of every block type and seals them into blocks of many records
+     * A block is only mined and written once per batch instead of once per record. The pending records are
+     * kept in a sidecar file, so the records of a process that exits or is killed are sealed after the restart.
+     * A batch is marked in the file before it is handed over and dropped after, so a batch a kill caught in between
+     * is only sealed again if the handover did not reach the mining job.
+     */
+    class RecordPool {
+    public:
+        /**
+         * @brief Receives the records of one type to mine into a block
+         */
+        using Seal = std::function<void(blockchain::enums::BlockType, const std::vector<std::string>&)>;
+
+        /**
+         * @brief Tells whether a batch handed over in an earlier session already belongs to a mining job
+         */
+        using Claimed = std::function<bool(blockchain::enums::BlockType, const std::vector<std::string>&)>;
+
+        /**
+         * @brief Construct a new Record Pool object from the records in its file and start its timer thread
+         * The batches the last session was handing over are dropped if they were claimed, and wait again otherwise.
+         *
+         * @param filePath
+         * @param options
+         * @param seal
+         * @param claimed
+         */
+        RecordPool(const std::string& filePath, const RecordPoolOptions& options, Seal seal, Claimed claimed);
+
+        /**
+         * @brief Stop the timer thread, the pending records stay in the file
+         */
+        ~RecordPool();
+
+        RecordPool(const RecordPool&) = delete;
+        RecordPool& operator=(const RecordPool&) = delete;
+
+        /**
+         * @brief Add a record, and seal the records of its type if that fills the batch
+         *
+         * @param type
+         * @param information
+         * @return The number of records of the type still pending afterwards
+         */
+        size_t add(blockchain::enums::BlockType type, const std::string& information);
+
+        /**
+         * @brief Put back the records of a sealed batch whose block was not mined
+         * They wait as if they were just added, so they are sealed with the next batch of their type rather than right away.
+         *
+         * @param type
+         * @param records
+         */
+        void restore(blockchain::enums::BlockType type, const std::vector<std::string>& records);
+
+        /**
+         * @brief Seal the pending records of every type now, whatever the thresholds
+         *
+         * @return The number of blocks sealed
+         */
+        size_t sealAll();
+
+        /**
+         * @brief Get the records of a type that have not been sealed yet
+         *
+         * @param type
+         * @return
+         */
+        [[nodiscard]] std::vector<PendingRecord> getPending(blockchain::enums::BlockType type) const;
+
+        /**
+         * @brief Stop the timer thread
+         */
+        void stop();
+
+    private:
+        /**
+         * @brief Seal up to one batch of the pending records of a type
+         *
+         * @param type
+         * @return Whether a block was sealed
+         */
+        bool seal(blockchain::enums::BlockType type);
+
+        /**
+         * @brief The loop of the timer thread, seals the records that reached the age threshold
+         */
+        void run();
+
+        /**
+         * @brief Rewrite the file with the pending records
+         * Written to a temporary file first, so a kill mid-write leaves the previous records intact.
+         */
+        void write() const;
+
+        std::string filePath;
+        RecordPoolOptions options;
+        Seal onSeal;
+        mutable std::mutex mutex;
+        std::mutex sealMutex; /** Keeps two seals of the same records apart */
+        std::condition_variable changed;
+        std::map<blockchain::enums::BlockType, std::vector<PendingRecord>> pending;
+        uint64_t nextBatch = 1;
+        bool stopping = false;
+        std::thread timer;
+    };
+} // namespace blockchain::pool
@@ -0,0 +1,169 @@
+#include "ChainVerifier.h"
+#include "../mining/MiningTraits.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace blockchain::verification {
+    namespace {
+        /**
+         * @brief The room a serialized header of any hash algorithm takes in the batch buffer
+         */
+        constexpr size_t HEADER_SIZE = mining::HeaderLayout<enums::HashAlgorithm::SHA512>::MAX_SIZE;
+
+        /**
+         * @brief Hash serialized headers of the same length with the multi-buffer kernel of their algorithm
+         * The headers that do not fill every lane of a last kernel call are hashed one at a time.
+         *
+         * @tparam Algorithm
+         * @param serialized The headers of the batch, HEADER_SIZE bytes apart
+         * @param length The length of every header of the group
+         * @param group The positions of the headers in the batch
+         * @param hashes The hashes of the batch, by position
+         */
+        template <enums::HashAlgorithm Algorithm>
+        void hashHeaders(const std::vector<uint8_t>& serialized, size_t length, const std::vector<size_t>& group, std::vector<hashing::Digest>& hashes) {
+            using Traits = mining::HashTraits<Algorithm>;
+            constexpr size_t LANES = Traits::Kernel::LANES;
+
+            const unsigned char* messages[LANES];
+            unsigned char digests[LANES][Traits::DIGEST_SIZE];
+            size_t next = 0;
+            for (; next + LANES <= group.size(); next += LANES) {
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    messages[lane] = &serialized[group[next + lane] * HEADER_SIZE];
+                }
+                Traits::hashLanes(messages, length, digests);
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    hashing::Digest& hash = hashes[group[next + lane]];
+                    std::memcpy(hash.bytes.data(), digests[lane], Traits::DIGEST_SIZE);
+                    hash.size = Traits::DIGEST_SIZE;
+                }
+            }
+
+            for (; next < group.size(); ++next) {
+                hashing::Digest& hash = hashes[group[next]];
+                typename Traits::Context ctx;
+                ctx.init();
+                ctx.update(&serialized[group[next] * HEADER_SIZE], length);
+                ctx.final(hash.bytes.data());
+                hash.size = Traits::DIGEST_SIZE;
+            }
+        }
+    }
+
+    bool VerificationReport::isValid() const {
+        return faults.empty();
+    }
+
+    std::optional<int> VerificationReport::getFirstFailingHeight() const {
+        if (faults.empty()) {
+            return std::nullopt;
+        }
+        return faults.front().height;
+    }
+
+    ChainVerifier::ChainVerifier(unsigned int threads) : threads(threads) {}
+
+    VerificationReport ChainVerifier::verify(const std::vector<std::shared_ptr<Block>>& blocks) const {
+        VerificationReport report;
+        report.blockCount = blocks.size();
+
+        const size_t batchCount = (blocks.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+        unsigned int threadCount = threads > 0 ? threads : std::thread::hardware_concurrency();
+        threadCount = static_cast<unsigned int>(std::min<size_t>(std::max(threadCount, 1U), batchCount));
+
+        std::atomic<size_t> nextBatch{0};
+        std::mutex faultsMutex;
+
+        auto worker = [&] {
+            std::vector<BlockFault> faults;
+            for (size_t batch = nextBatch++; batch < batchCount; batch = nextBatch++) {
+                const size_t begin = batch * BATCH_SIZE;
+                const size_t end = std::min(blocks.size(), begin + BATCH_SIZE);
+                const std::vector<hashing::Digest> hashes = computeHashes(blocks, begin, end);
+                for (size_t i = begin; i < end; ++i) {
+                    BlockFault fault = verifyBlock(blocks, i, hashes[i - begin]);
+                    if (fault.hash || fault.previousHash || fault.merkleRoot) {
+                        faults.push_back(fault);
+                    }
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(faultsMutex);
+            report.faults.insert(report.faults.end(), faults.begin(), faults.end());
+        };
+
+        if (threadCount <= 1) {
+            worker(); // No point in spawning a thread for a single worker
+        } else {
+            std::vector<std::thread> pool;
+            for (unsigned int t = 0; t < threadCount; ++t) {
+                pool.emplace_back(worker);
+            }
+            for (auto& thread : pool) {
+                thread.join();
+            }
+        }
+
+        // The batches finish in any order
+        std::sort(report.faults.begin(), report.faults.end(), [](const BlockFault& a, const BlockFault& b) { return a.height < b.height; });
+        return report;
+    }
+
+    std::vector<hashing::Digest> ChainVerifier::computeHashes(const std::vector<std::shared_ptr<Block>>& blocks, size_t begin, size_t end) {
+        std::vector<hashing::Digest> hashes(end - begin);
+        std::vector<uint8_t> serialized((end - begin) * HEADER_SIZE);
+
+        // The previous hash of a header is as long as the digest of its parent, so headers of one algorithm can differ in length
+        std::map<std::pair<enums::HashAlgorithm, size_t>, std::vector<size_t>> groups;
+        for (size_t i = begin; i < end; ++i) {
+            Block& block = *blocks[i];
+            const BlockHeader& header = block.getHeader(); // By reference, the const overload copies
+            if (block.isGenesis()) {
+                hashes[i - begin] = header.computeHash(true); // Hashed over a zero previous hash, not the link it stores
+                continue;
+            }
+
+            const size_t length = header.serialize(&serialized[(i - begin) * HEADER_SIZE]);
+            groups[{hashing::Hasher::forBlockType(header.getType()).getAlgorithm(), length}].push_back(i - begin);
+        }
+
+        for (const auto& [key, group] : groups) {
+            switch (key.first) {
+                case enums::HashAlgorithm::SHA256:
+                default:
+                    hashHeaders<enums::HashAlgorithm::SHA256>(serialized, key.second, group, hashes);
+                    break;
+                case enums::HashAlgorithm::SHA384:
+                    hashHeaders<enums::HashAlgorithm::SHA384>(serialized, key.second, group, hashes);
+                    break;
+                case enums::HashAlgorithm::SHA512:
+                    hashHeaders<enums::HashAlgorithm::SHA512>(serialized, key.second, group, hashes);
+                    break;
+            }
+        }
+        return hashes;
+    }
+
+    BlockFault ChainVerifier::verifyBlock(const std::vector<std::shared_ptr<Block>>& blocks, size_t index, const hashing::Digest& hash) {
+        Block& block = *blocks[index];
+        const BlockHeader& header = block.getHeader(); // By reference, the const overload copies
+
+        BlockFault fault;
+        fault.height = block.getHeight();
+        fault.hash = hash != header.getHashDigest();
+        fault.merkleRoot = header.computeMerkleRoot() != header.getMerkleRootDigest();
+
+        // A genesis block links to its own hash
+        if (block.isGenesis()) {
+            fault.previousHash = header.getPrevHashDigest() != header.getHashDigest();
+        } else {
+            fault.previousHash = index == 0 || header.getPrevHashDigest() != blocks[index - 1]->getHeader().getHashDigest();
+        }
+        return fault;
+    }
+} // namespace blockchain::verification
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "../Block.h"
+
+namespace blockchain::verification {
+    /**
+     * @brief The checks a block failed
+     */
+    struct BlockFault {
+        int height = 0; /** The height of the block */
+        bool hash = false; /** The stored hash is not the hash of the header */
+        bool previousHash = false; /** The stored previous hash is not the hash of the block before */
+        bool merkleRoot = false; /** The stored merkle root is not the hash of the information */
+    };
+
+    /**
+     * @brief The outcome of verifying a chain
+     */
+    struct VerificationReport {
+        size_t blockCount = 0; /** The number of blocks checked */
+        std::vector<BlockFault> faults; /** The failing blocks, in ascending height */
+
+        /**
+         * @brief Check whether every block passed
+         *
+         * @return
+         */
+        [[nodiscard]] bool isValid() const;
+
+        /**
+         * @brief Get the height of the first failing block
+         *
+         * @return Nothing if every block passed
+         */
+        [[nodiscard]] std::optional<int> getFirstFailingHeight() const;
+    };
+
+    /**
+     * @brief Checks the stored hashes, links and merkle roots of every block of a chain on a pool of threads
+     * The stored hashes are known up front, so each block is checked on its own against the block before it
+     * and the blocks can be dealt to the threads in any order. Within a batch, the headers are hashed several at a
+     * time with the multi-buffer kernel of their hash algorithm.
+     */
+    class ChainVerifier {
+    public:
+        /**
+         * @brief The number of blocks a thread claims at a time
+         */
+        static constexpr size_t BATCH_SIZE = 4096;
+
+        /**
+         * @brief Construct a new Chain Verifier object
+         *
+         * @param threads The number of threads checking blocks, 0 uses every hardware thread
+         */
+        explicit ChainVerifier(unsigned int threads = 0);
+
+        /**
+         * @brief Verify the blocks of a chain
+         * The blocks must not change while they are verified.
+         *
+         * @param blocks
+         * @return
+         */
+        [[nodiscard]] VerificationReport verify(const std::vector<std::shared_ptr<Block>>& blocks) const;
+
+    private:
+        unsigned int threads;
+
+        /**
+         * @brief Recompute the hashes of the headers of a batch of blocks
+         * Headers of the same hash algorithm and length fill the lanes of one kernel call, the ones left over
+         * and the genesis block are hashed one at a time.
+         *
+         * @param blocks
+         * @param begin The index of the first block of the batch
+         * @param end The index after the last block of the batch
+         * @return The hash of every block of the batch, in order
+         */
+        static std::vector<hashing::Digest> computeHashes(const std::vector<std::shared_ptr<Block>>& blocks, size_t begin, size_t end);
+
+        /**
+         * @brief Check one block against the block before it
+         *
+         * @param blocks
+         * @param index
+         * @param hash The recomputed hash of the header of the block
+         * @return The checks the block failed
+         */
+        static BlockFault verifyBlock(const std::vector<std::shared_ptr<Block>>& blocks, size_t index, const hashing::Digest& hash);
+    };
+} // namespace blockchain::verification
@@ -92,7 +92,7 @@ namespace collection {
         return blockchain::TransporterInfo(std::stoi(id), name, productType, transportationType, orderingType, orderingAmount);
     }
 
-    blockchain::TransactionInfo InputCollector::collectTransactionInfo(const std::string& optionsFilePath, const std::string& recordsFilePath) {
+    blockchain::TransactionInfo InputCollector::collectTransactionInfo(const std::string& optionsFilePath, const std::string& recordsFilePath, const std::vector<int>& pendingIds) {
         int id, productOrderingLimit;
         std::string totalFees, commisionFees, retailerPerTripCreditBalance, annualOrderingCreditBalance, paymentType;
 
@@ -101,6 +101,7 @@ namespace collection {
         auto allPaymentTypes = reader.getAllInitialOptions();
 
         std::vector<int> transactionIds = filesystem::FileReader::extractBlockIds(recordsFilePath, "Transaction");
+        transactionIds.insert(transactionIds.end(), pendingIds.begin(), pendingIds.end());
 
         id = std::stoi(collection::validation::InputValidator::validateUniqueIdInt("transaction ID (unique)", transactionIds));
         totalFees = collection::validation::InputValidator::validateString("transaction fees (RM)");
@@ -128,7 +129,7 @@ namespace collection {
         return std::make_pair(static_cast<blockchain::enums::BlockAttribute>(searchByAttr - 1), searchValue);
     }
 
-    void InputCollector::collectBlockManipulationCriteria(blockchain::Chain& blockchain, blockchain::Chain& redactedBlockchain, const std::vector<std::string>& searchOptions) {
+    void InputCollector::collectBlockManipulationCriteria(blockchain::Chain& blockchain, blockchain::Chain& redactedBlockchain, blockchain::mining::MiningService& miningService, const std::vector<std::string>& searchOptions) {
         using namespace blockchain::enums;
 
         std::vector<std::string> types = { "Edit", "Delete", "Mine Edited Blocks" };
@@ -178,9 +179,18 @@ namespace collection {
                 return;
             }
 
-            redactedBlockchain.editBlock(foundBlocks[0], infoPtr->toString());
+            // A block of several records only has the chosen record replaced
+            auto records = blockchain::hashing::MerkleTree::splitRecords(foundBlocks[0]->getHeader().getInformationString());
+            size_t recordIndex = 0;
+            if (records.size() > 1) {
+                recordIndex = validation::InputValidator::validateSelectionInt("the record to replace", records) - 1;
+            }
+            records[recordIndex] = infoPtr->toString();
+            const std::string information = blockchain::Block::joinRecords(records);
+
+            redactedBlockchain.editBlock(foundBlocks[0], information);
             if (editType == 2) {
-                blockchain.hardEditBlock(foundBlocks[0], infoPtr->toString());
+                blockchain.hardEditBlock(foundBlocks[0], information);
             }
 
             std::cout << "Block edited successfully." << std::endl << std::endl;
@@ -228,16 +238,15 @@ namespace collection {
                 return;
             }
 
-            if (foundBlocks[0]->getHeader().isMined()) {
-                std::cout << "Block Hash value is already mined to the correct pattern." << std::endl << std::endl;
-                return;
-            }
-
-            // Found only one block and has validity to be remined, proceed with mining
-            redactedBlockchain.mineBlock(foundBlocks[0]);
-            blockchain.mineBlock(foundBlocks[0]);
+            // Found only one block, re-mine it and the blocks after it ahead of the queued new blocks
+            // The chains share their blocks, so re-mining through the full chain updates the redacted one as well
+            auto block = foundBlocks[0];
+            std::string description = "Re-mine from block " + std::to_string(block->getHeight());
+            auto handle = miningService.submit(description, blockchain::enums::MiningPriority::HIGH, [&blockchain, block]{
+                return blockchain.cascadeMine(block);
+            });
 
-            std::cout << "Block mined successfully." << std::endl << std::endl;
+            std::cout << "Blocks queued for mining as job " << handle.id << "." << std::endl << std::endl;
         }
     }
 } // namespace collection
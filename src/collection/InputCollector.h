@@ -5,6 +5,7 @@
 #include "../blockchain/TransactionBlock.h"
 #include "../blockchain/enums/BlockAttribute.h"
 #include "../blockchain/Chain.h"
+#include "../blockchain/mining/MiningService.h"
 
 namespace collection {
     class InputCollector {
@@ -37,9 +38,10 @@ namespace collection {
          *
          * @param optionsFilePath
          * @param recordsFilePath
+         * @param pendingIds The IDs of the records that are not in the records file yet
          * @return
          */
-        static blockchain::TransactionInfo collectTransactionInfo(const std::string& optionsFilePath, const std::string& recordsFilePath);
+        static blockchain::TransactionInfo collectTransactionInfo(const std::string& optionsFilePath, const std::string& recordsFilePath, const std::vector<int>& pendingIds = {});
 
         /**
          * @brief Collects the search criteria from the participant.
@@ -58,8 +60,9 @@ namespace collection {
          *
          * @param blockchain
          * @param redactedBlockchain
+         * @param miningService The queue the block is mined on
          * @param searchOptions
          */
-        static void collectBlockManipulationCriteria(blockchain::Chain& blockchain, blockchain::Chain& redactedBlockchain, const std::vector<std::string>& searchOptions);
+        static void collectBlockManipulationCriteria(blockchain::Chain& blockchain, blockchain::Chain& redactedBlockchain, blockchain::mining::MiningService& miningService, const std::vector<std::string>& searchOptions);
     };
 }
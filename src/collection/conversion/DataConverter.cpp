@@ -73,24 +73,33 @@ namespace conversion {
         return infoMap;
     }
 
-    blockchain::SupplierBlock DataConverter::convertToSupplierBlock(int version, const std::string bits, int height, int nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible) {
-        auto infoDetails = parseInformationField(data);
-        blockchain::SupplierInfo info(std::stoi(infoDetails["ID"]), infoDetails["Name"], infoDetails["Location"], infoDetails["Branch"], infoDetails["Items"]);
+    blockchain::SupplierBlock DataConverter::convertToSupplierBlock(int version, const std::string bits, int height, uint32_t nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible) {
+        std::vector<blockchain::SupplierInfo> records;
+        for (const auto& record : blockchain::hashing::MerkleTree::splitRecords(data)) {
+            auto infoDetails = parseInformationField(record);
+            records.emplace_back(std::stoi(infoDetails["ID"]), infoDetails["Name"], infoDetails["Location"], infoDetails["Branch"], infoDetails["Items"]);
+        }
 
-        return blockchain::SupplierBlock(version, bits, height, previousHash, info, nonce, currentHash, visible);
+        return blockchain::SupplierBlock(version, bits, height, previousHash, records, nonce, currentHash, visible);
     }
 
-    blockchain::TransporterBlock DataConverter::convertToTransporterBlock(int version, const std::string bits, int height, int nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible) {
-        auto infoDetails = parseInformationField(data);
-        blockchain::TransporterInfo info(std::stoi(infoDetails["ID"]), infoDetails["Name"], infoDetails["Product Type"], infoDetails["Transportation Type"], infoDetails["Ordering Type"], std::stod(infoDetails["Ordering Amount (Kg)"]));
+    blockchain::TransporterBlock DataConverter::convertToTransporterBlock(int version, const std::string bits, int height, uint32_t nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible) {
+        std::vector<blockchain::TransporterInfo> records;
+        for (const auto& record : blockchain::hashing::MerkleTree::splitRecords(data)) {
+            auto infoDetails = parseInformationField(record);
+            records.emplace_back(std::stoi(infoDetails["ID"]), infoDetails["Name"], infoDetails["Product Type"], infoDetails["Transportation Type"], infoDetails["Ordering Type"], std::stod(infoDetails["Ordering Amount (Kg)"]));
+        }
 
-        return blockchain::TransporterBlock(version, bits, height, previousHash, info, nonce, currentHash, visible);
+        return blockchain::TransporterBlock(version, bits, height, previousHash, records, nonce, currentHash, visible);
     }
 
-    blockchain::TransactionBlock DataConverter::convertToTransactionBlock(int version, const std::string bits, int height, int nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible) {
-        auto infoDetails = parseInformationField(data);
+    blockchain::TransactionBlock DataConverter::convertToTransactionBlock(int version, const std::string bits, int height, uint32_t nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible) {
+        std::vector<blockchain::TransactionInfo> records;
+        for (const auto& record : blockchain::hashing::MerkleTree::splitRecords(data)) {
+            auto infoDetails = parseInformationField(record);
+            records.emplace_back(std::stoi(infoDetails["ID"]), infoDetails["Total Fees (RM)"], infoDetails["Commission Fees (RM)"], infoDetails["Retailer Per-Trip Credit Balance (RM)"], infoDetails["Annual Ordering Credit Balance (RM)"], infoDetails["Payment Type"], infoDetails["Product Ordering Limit"]);
+        }
 
-        blockchain::TransactionInfo info(std::stoi(infoDetails["ID"]), infoDetails["Total Fees (RM)"], infoDetails["Commission Fees (RM)"], infoDetails["Retailer Per-Trip Credit Balance (RM)"], infoDetails["Annual Ordering Credit Balance (RM)"], infoDetails["Payment Type"], infoDetails["Product Ordering Limit"]);
-        return blockchain::TransactionBlock(version, bits, height, previousHash, info, nonce, currentHash, visible);
+        return blockchain::TransactionBlock(version, bits, height, previousHash, records, nonce, currentHash, visible);
     }
 }
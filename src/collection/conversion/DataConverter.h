@@ -22,7 +22,7 @@ namespace conversion {
          * @param visible
          * @return
          */
-        static blockchain::SupplierBlock convertToSupplierBlock(int version, const std::string bits, int height, int nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible);
+        static blockchain::SupplierBlock convertToSupplierBlock(int version, const std::string bits, int height, uint32_t nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible);
 
         /**
          * @brief Convert given values into a TransporterBlock object
@@ -37,7 +37,7 @@ namespace conversion {
          * @param visible
          * @return
          */
-        static blockchain::TransporterBlock convertToTransporterBlock(int version, const std::string bits, int height, int nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible);
+        static blockchain::TransporterBlock convertToTransporterBlock(int version, const std::string bits, int height, uint32_t nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible);
 
         /**
          * @brief Convert given values into a TransactionBlock object
@@ -52,7 +52,7 @@ namespace conversion {
          * @param visible
          * @return
          */
-        static blockchain::TransactionBlock convertToTransactionBlock(int version, const std::string bits, int height, int nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible);
+        static blockchain::TransactionBlock convertToTransactionBlock(int version, const std::string bits, int height, uint32_t nonce, const std::string& currentHash, const std::string& previousHash, const std::string& data, bool visible);
     };
 }
 
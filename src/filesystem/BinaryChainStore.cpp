@@ -0,0 +1,255 @@
+#include "BinaryChainStore.h"
+#include "../../libs/crc32c/crc32c.h"
+#include "../../libs/hex/hex.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace filesystem {
+    namespace {
+        const uint8_t FLAG_VISIBLE = 0x01;
+        const uint8_t FLAG_MINED = 0x02;
+        const uint8_t FLAG_TIMESTAMP = 0x04;
+        const uint8_t FIELD_TEXT = 0x80; /** Set on a field kept as text because it is not lowercase hexadecimal */
+        const size_t RECORD_HEADER_SIZE = 8;
+        const uint32_t MAX_PAYLOAD_SIZE = 1u << 30;
+
+        /**
+         * @brief Compute the checksum of a payload
+         *
+         * @param payload
+         * @return
+         */
+        uint32_t checksum(const std::string& payload) {
+            return Crc32c::compute(reinterpret_cast<const unsigned char*>(payload.data()), payload.size());
+        }
+
+        void putUint32(std::string& out, uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+            }
+        }
+
+        uint32_t getUint32(const char* in) {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+            }
+            return value;
+        }
+
+        /**
+         * @brief Append an unsigned number in 7-bit groups, the lowest first, the high bit marking that more follow
+         *
+         * @param out
+         * @param value
+         */
+        void putVarint(std::string& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        /**
+         * @brief Append a signed number as a varint, zigzagged so small negative numbers stay short
+         *
+         * @param out
+         * @param value
+         */
+        void putSignedVarint(std::string& out, int64_t value) {
+            putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        /**
+         * @brief Append a hash, merkle root or bits field as raw bytes, or as text if it is not lowercase hexadecimal
+         *
+         * @param out
+         * @param field
+         */
+        void putHexField(std::string& out, const std::string& field) {
+            if (field.size() / 2 >= FIELD_TEXT) {
+                throw std::runtime_error("Block field too long for the binary chain format: " + field);
+            }
+
+            // Decoded in place after the length, the length byte is only set once the field turned out to be hexadecimal
+            const size_t start = out.size();
+            out.resize(start + 1 + field.size() / 2);
+            unsigned char* bytes = reinterpret_cast<unsigned char*>(&out[start + 1]);
+            bool lowercase = std::none_of(field.begin(), field.end(), [](char c) { return c >= 'A' && c <= 'F'; });
+            if (lowercase && Hex::decode(field.data(), field.size(), bytes)) {
+                out[start] = static_cast<char>(field.size() / 2);
+                return;
+            }
+
+            if (field.size() >= FIELD_TEXT) {
+                throw std::runtime_error("Block field too long for the binary chain format: " + field);
+            }
+            out.resize(start);
+            out.push_back(static_cast<char>(FIELD_TEXT | field.size()));
+            out.append(field);
+        }
+
+        /**
+         * @brief Reads the fields of a payload, throwing once it would read past its end
+         */
+        class PayloadReader {
+        public:
+            explicit PayloadReader(const std::string& payload) : payload(payload) {}
+
+            uint8_t getByte() {
+                return static_cast<uint8_t>(*take(1));
+            }
+
+            uint64_t getVarint() {
+                uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    uint8_t byte = getByte();
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0) {
+                        return value;
+                    }
+                }
+                throw std::runtime_error("Corrupt varint in the binary chain file.");
+            }
+
+            int64_t getSignedVarint() {
+                uint64_t value = getVarint();
+                return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+            }
+
+            std::string getBytes(size_t count) {
+                return std::string(take(count), count);
+            }
+
+            std::string getHexField() {
+                const uint8_t tag = getByte();
+                const size_t count = tag & ~FIELD_TEXT;
+                const char* bytes = take(count);
+                if (tag & FIELD_TEXT) {
+                    return std::string(bytes, count);
+                }
+
+                std::string hex(count * 2, '0');
+                Hex::encode(reinterpret_cast<const unsigned char*>(bytes), count, hex.data());
+                return hex;
+            }
+
+        private:
+            const char* take(size_t count) {
+                if (count > payload.size() - position) {
+                    throw std::runtime_error("Record shorter than its fields in the binary chain file.");
+                }
+                const char* bytes = payload.data() + position;
+                position += count;
+                return bytes;
+            }
+
+            const std::string& payload;
+            size_t position = 0;
+        };
+    }
+
+    // Starts with a non-ASCII byte and holds a line break, so a file mangled as text no longer matches
+    const std::string BinaryChainStore::MAGIC = std::string("\x89" "CHAIN\r\n", 8);
+    const uint8_t BinaryChainStore::FORMAT_VERSION = 1;
+
+    ChainFormat BinaryChainStore::getFormat() const {
+        return ChainFormat::BINARY;
+    }
+
+    std::ios::openmode BinaryChainStore::getOpenMode() const {
+        return std::ios::binary;
+    }
+
+    void BinaryChainStore::writeHeader(std::ostream& out) const {
+        out.write(MAGIC.data(), static_cast<std::streamsize>(MAGIC.size()));
+        out.put(static_cast<char>(FORMAT_VERSION));
+    }
+
+    void BinaryChainStore::readHeader(std::istream& in) const {
+        std::string magic(MAGIC.size(), '\0');
+        char version = 0;
+        if (!in.read(&magic[0], static_cast<std::streamsize>(magic.size())) || magic != MAGIC || !in.get(version)) {
+            throw std::runtime_error("Not a binary chain file: " + filePath);
+        }
+        if (static_cast<uint8_t>(version) != FORMAT_VERSION) {
+            throw std::runtime_error("Unsupported binary chain format version " + std::to_string(static_cast<uint8_t>(version)) + ": " + filePath);
+        }
+    }
+
+    void BinaryChainStore::writeRecord(std::ostream& out, const BlockData& record) const {
+        std::string payload;
+        uint8_t flags = (record.visible ? FLAG_VISIBLE : 0) | (record.mined ? FLAG_MINED : 0) | (record.timestamp.empty() ? 0 : FLAG_TIMESTAMP);
+        payload.push_back(static_cast<char>(record.type));
+        payload.push_back(static_cast<char>(flags));
+        putSignedVarint(payload, record.height);
+        putSignedVarint(payload, record.version);
+        putVarint(payload, record.nonce);
+        if (!record.timestamp.empty()) {
+            try {
+                putSignedVarint(payload, std::stoll(record.timestamp));
+            } catch (const std::logic_error&) {
+                throw std::runtime_error("Block timestamp is not a number: " + record.timestamp);
+            }
+        }
+        putVarint(payload, record.miningTime);
+        putHexField(payload, record.currentHash);
+        putHexField(payload, record.previousHash);
+        putHexField(payload, record.merkleRoot);
+        putHexField(payload, record.bits);
+        putVarint(payload, record.information.size());
+        payload.append(record.information);
+
+        std::string header;
+        putUint32(header, static_cast<uint32_t>(payload.size()));
+        putUint32(header, checksum(payload));
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    }
+
+    bool BinaryChainStore::readRecord(std::istream& in, BlockData& record) const {
+        // A record cut short is one a kill interrupted mid-append, it ends the file rather than failing it
+        char header[RECORD_HEADER_SIZE];
+        if (!in.read(header, RECORD_HEADER_SIZE)) {
+            return false;
+        }
+
+        const uint32_t size = getUint32(header);
+        if (size > MAX_PAYLOAD_SIZE) {
+            throw std::runtime_error("Corrupt record length in the binary chain file: " + filePath);
+        }
+        std::string payload(size, '\0');
+        if (!in.read(&payload[0], size)) {
+            return false;
+        }
+        if (checksum(payload) != getUint32(header + 4)) {
+            throw std::runtime_error("Record fails its checksum in the binary chain file: " + filePath);
+        }
+
+        PayloadReader reader(payload);
+        record = BlockData();
+        const uint8_t type = reader.getByte();
+        if (type > static_cast<uint8_t>(blockchain::enums::BlockType::TRANSACTION)) {
+            throw std::runtime_error("Unknown block type in the binary chain file: " + filePath);
+        }
+        record.type = static_cast<blockchain::enums::BlockType>(type);
+
+        const uint8_t flags = reader.getByte();
+        record.visible = flags & FLAG_VISIBLE;
+        record.mined = flags & FLAG_MINED;
+        record.height = static_cast<int>(reader.getSignedVarint());
+        record.version = static_cast<int>(reader.getSignedVarint());
+        record.nonce = static_cast<uint32_t>(reader.getVarint());
+        if (flags & FLAG_TIMESTAMP) {
+            record.timestamp = std::to_string(reader.getSignedVarint());
+        }
+        record.miningTime = reader.getVarint();
+        record.currentHash = reader.getHexField();
+        record.previousHash = reader.getHexField();
+        record.merkleRoot = reader.getHexField();
+        record.bits = reader.getHexField();
+        record.information = reader.getBytes(reader.getVarint());
+        return true;
+    }
+} // namespace filesystem
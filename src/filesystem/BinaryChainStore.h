@@ -0,0 +1,40 @@
+#ifndef BINARYCHAINSTORE_H
+#define BINARYCHAINSTORE_H
+
+#include <cstdint>
+#include "ChainStore.h"
+
+namespace filesystem {
+    /**
+     * @brief Keeps a chain as binary records
+     * The file starts with a magic and the format version. Every record is a fixed header, holding the length of
+     * its payload and the CRC-32C of it, and the payload: the type and flags, the hashes, merkle root and bits as
+     * raw bytes, the numbers as varints and the information as a length-prefixed string.
+     * A record cut short by a kill mid-append ends the file, a record failing its CRC throws.
+     */
+    class BinaryChainStore : public ChainStore {
+    public:
+        /**
+         * @brief The first bytes of a binary chain file
+         */
+        static const std::string MAGIC;
+
+        /**
+         * @brief The version of the record layout, written after the magic
+         */
+        static const uint8_t FORMAT_VERSION;
+
+        using ChainStore::ChainStore;
+
+        [[nodiscard]] ChainFormat getFormat() const override;
+
+    protected:
+        [[nodiscard]] std::ios::openmode getOpenMode() const override;
+        void writeHeader(std::ostream& out) const override;
+        void readHeader(std::istream& in) const override;
+        void writeRecord(std::ostream& out, const BlockData& record) const override;
+        bool readRecord(std::istream& in, BlockData& record) const override;
+    };
+} // namespace filesystem
+
+#endif // BINARYCHAINSTORE_H
@@ -0,0 +1,295 @@
+#include "ChainStore.h"
+#include "BinaryChainStore.h"
+#include "TextChainStore.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace filesystem {
+    namespace {
+        /**
+         * @brief Get the size of a file, 0 when it is missing
+         *
+         * @param filePath
+         * @return
+         */
+        std::streamoff fileSize(const std::string& filePath) {
+            std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+            return file.is_open() ? static_cast<std::streamoff>(file.tellg()) : 0;
+        }
+
+        /**
+         * @brief A file opened for positioned reads and writes, closed when it goes out of scope
+         */
+        class PosixFile {
+        public:
+            PosixFile(const std::string& filePath, int flags) : filePath(filePath), fd(::open(filePath.c_str(), flags, 0644)) {
+                if (fd < 0) {
+                    throw std::runtime_error("Failed to open file: " + filePath + ": " + std::strerror(errno));
+                }
+            }
+
+            ~PosixFile() {
+                ::close(fd);
+            }
+
+            PosixFile(const PosixFile&) = delete;
+            PosixFile& operator=(const PosixFile&) = delete;
+
+            void writeAt(const std::string& bytes, std::streamoff offset) const {
+                for (size_t written = 0; written < bytes.size();) {
+                    ssize_t count = ::pwrite(fd, bytes.data() + written, bytes.size() - written, static_cast<off_t>(offset + written));
+                    if (count < 0 && errno != EINTR) {
+                        throw std::runtime_error("Failed to write file: " + filePath + ": " + std::strerror(errno));
+                    }
+                    written += count > 0 ? static_cast<size_t>(count) : 0;
+                }
+            }
+
+            [[nodiscard]] std::string readAt(std::streamoff offset, std::streamoff size) const {
+                std::string bytes(static_cast<size_t>(size), '\0');
+                for (size_t read = 0; read < bytes.size();) {
+                    ssize_t count = ::pread(fd, &bytes[read], bytes.size() - read, static_cast<off_t>(offset + read));
+                    if (count == 0 || (count < 0 && errno != EINTR)) {
+                        throw std::runtime_error("Failed to read file: " + filePath);
+                    }
+                    read += count > 0 ? static_cast<size_t>(count) : 0;
+                }
+                return bytes;
+            }
+
+            void truncate(std::streamoff size) const {
+                if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                    throw std::runtime_error("Failed to truncate file: " + filePath + ": " + std::strerror(errno));
+                }
+            }
+
+        private:
+            const std::string& filePath;
+            int fd;
+        };
+    }
+
+    ChainStore::ChainStore(const std::string& filePath) : filePath(filePath) {}
+
+    std::unique_ptr<ChainStore> ChainStore::open(const std::string& filePath, ChainFormat format) {
+        return create(filePath, detect(filePath, format));
+    }
+
+    std::unique_ptr<ChainStore> ChainStore::create(const std::string& filePath, ChainFormat format) {
+        switch (format) {
+            case ChainFormat::BINARY:
+                return std::make_unique<BinaryChainStore>(filePath);
+            case ChainFormat::TEXT:
+            default:
+                return std::make_unique<TextChainStore>(filePath);
+        }
+    }
+
+    ChainFormat ChainStore::detect(const std::string& filePath, ChainFormat fallback) {
+        std::ifstream file(filePath, std::ios::binary);
+        std::string magic(BinaryChainStore::MAGIC.size(), '\0');
+        if (!file.read(&magic[0], static_cast<std::streamsize>(magic.size()))) {
+            // Too short for the magic, a file with no records yet takes the format asked for
+            return fileSize(filePath) == 0 ? fallback : ChainFormat::TEXT;
+        }
+        return magic == BinaryChainStore::MAGIC ? ChainFormat::BINARY : ChainFormat::TEXT;
+    }
+
+    ChainFormat ChainStore::parseFormat(const std::string& format) {
+        if (format == "text") {
+            return ChainFormat::TEXT;
+        } else if (format == "binary") {
+            return ChainFormat::BINARY;
+        }
+        throw std::invalid_argument("Unknown chain format: " + format);
+    }
+
+    size_t ChainStore::convert(const std::string& sourcePath, const std::string& targetPath, ChainFormat format) {
+        auto source = open(sourcePath, format);
+        auto target = create(targetPath, format);
+
+        std::ifstream in(sourcePath, std::ios::in | source->getOpenMode());
+        if (!in.is_open()) {
+            throw std::runtime_error("Failed to open file: " + sourcePath);
+        }
+        std::ofstream out(targetPath, std::ios::out | std::ios::trunc | target->getOpenMode());
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open file for writing: " + targetPath);
+        }
+
+        size_t count = 0;
+        if (fileSize(sourcePath) > 0) {
+            source->readHeader(in);
+            target->writeHeader(out);
+
+            BlockData record;
+            while (source->readRecord(in, record)) {
+                target->writeRecord(out, record);
+                ++count;
+            }
+        }
+
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write file: " + targetPath);
+        }
+        return count;
+    }
+
+    bool ChainStore::migrate(const std::string& filePath, ChainFormat format) {
+        if (fileSize(filePath) == 0 || detect(filePath, format) == format) {
+            return false;
+        }
+
+        const std::string temporaryPath = filePath + ".tmp";
+        convert(filePath, temporaryPath, format);
+        if (std::rename(temporaryPath.c_str(), filePath.c_str()) != 0) {
+            throw std::runtime_error("Failed to replace file: " + filePath);
+        }
+        return true;
+    }
+
+    void ChainStore::scan(const std::function<void(const BlockData&)>& visit) const {
+        readRecords([&visit](BlockData& record, std::streamoff) { visit(record); });
+    }
+
+    std::vector<BlockData> ChainStore::load() const {
+        std::vector<BlockData> records;
+        readRecords([&records](BlockData& record, std::streamoff) { records.push_back(std::move(record)); });
+        return records;
+    }
+
+    std::streamoff ChainStore::readRecords(const std::function<void(BlockData&, std::streamoff)>& visit) const {
+        std::ifstream in(filePath, std::ios::in | getOpenMode());
+        if (!in.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filePath);
+        }
+        const std::streamoff size = fileSize(filePath);
+        if (size == 0) {
+            return 0;
+        }
+
+        readHeader(in);
+        BlockData record;
+        std::streamoff offset = in.tellg();
+        while (readRecord(in, record)) {
+            visit(record, offset);
+            offset = in.tellg();
+            if (offset < 0) {
+                offset = size; // The last record ran up to the end of the file
+            }
+        }
+        return offset;
+    }
+
+    void ChainStore::append(const BlockData& record) {
+        append(std::vector<BlockData>{record});
+    }
+
+    void ChainStore::append(const std::vector<BlockData>& records) {
+        index();
+
+        // Written at the end of the last whole record, so a record a kill cut short is overwritten
+        std::string bytes = end == 0 ? encodeHeader() : "";
+        for (const auto& record : records) {
+            offsets.push_back(end + static_cast<std::streamoff>(bytes.size()));
+            bytes += encodeRecord(record);
+        }
+
+        PosixFile file(filePath, O_WRONLY | O_CREAT);
+        file.writeAt(bytes, end);
+        end += static_cast<std::streamoff>(bytes.size());
+        file.truncate(end);
+    }
+
+    void ChainStore::update(size_t first, const std::vector<BlockData>& records) {
+        index();
+        const size_t last = first + records.size();
+        if (last > offsets.size()) {
+            throw std::out_of_range("The chain file holds " + std::to_string(offsets.size()) + " records, not " + std::to_string(last) + ".");
+        }
+        if (records.empty()) {
+            return;
+        }
+
+        std::vector<std::string> encoded;
+        for (const auto& record : records) {
+            encoded.push_back(encodeRecord(record));
+        }
+        auto recordEnd = [this](size_t i) { return i + 1 < offsets.size() ? offsets[i + 1] : end; };
+
+        PosixFile file(filePath, O_RDWR);
+
+        // The records that kept their size are patched in place
+        size_t changed = first;
+        std::string patch;
+        for (; changed < last && static_cast<std::streamoff>(encoded[changed - first].size()) == recordEnd(changed) - offsets[changed]; ++changed) {
+            patch += encoded[changed - first];
+        }
+        file.writeAt(patch, offsets[first]);
+        if (changed == last) {
+            return;
+        }
+
+        // From the first record that changed size on, the rest of the file moves, so it is rewritten from there
+        const std::streamoff tailStart = recordEnd(last - 1);
+        std::string suffix;
+        for (size_t i = changed; i < last; ++i) {
+            offsets[i] = offsets[changed] + static_cast<std::streamoff>(suffix.size());
+            suffix += encoded[i - first];
+        }
+
+        const std::streamoff shift = offsets[changed] + static_cast<std::streamoff>(suffix.size()) - tailStart;
+        suffix += file.readAt(tailStart, end - tailStart);
+        for (size_t i = last; i < offsets.size(); ++i) {
+            offsets[i] += shift;
+        }
+
+        file.writeAt(suffix, offsets[changed]);
+        end += shift;
+        file.truncate(end);
+    }
+
+    void ChainStore::clear() {
+        PosixFile file(filePath, O_WRONLY | O_CREAT);
+        file.truncate(0);
+        offsets.clear();
+        end = 0;
+        indexed = true;
+    }
+
+    size_t ChainStore::getRecordCount() {
+        index();
+        return offsets.size();
+    }
+
+    void ChainStore::index() {
+        if (indexed) {
+            return;
+        }
+
+        offsets.clear();
+        end = fileSize(filePath) == 0 ? 0 : readRecords([this](BlockData&, std::streamoff offset) { offsets.push_back(offset); });
+        indexed = true;
+    }
+
+    std::string ChainStore::encodeHeader() const {
+        std::ostringstream out(std::ios::out | getOpenMode());
+        writeHeader(out);
+        return out.str();
+    }
+
+    std::string ChainStore::encodeRecord(const BlockData& record) const {
+        std::ostringstream out(std::ios::out | getOpenMode());
+        writeRecord(out, record);
+        return out.str();
+    }
+
+    const std::string& ChainStore::getFilePath() const { return filePath; }
+} // namespace filesystem
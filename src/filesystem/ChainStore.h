@@ -0,0 +1,206 @@
+#ifndef CHAINSTORE_H
+#define CHAINSTORE_H
+
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "FileReader.h"
+
+namespace filesystem {
+    /**
+     * @brief The record formats a chain file can be kept in
+     */
+    enum class ChainFormat {
+        TEXT, /** "Key: value" lines, one block per paragraph */
+        BINARY, /** Length-prefixed, checksummed records with binary digests and varint fields */
+    };
+
+    /**
+     * @brief Keeps the blocks of a chain in a file as a log of records, one per block
+     * A format only encodes and decodes single records, so reading, appending and converting stream through the
+     * file one record at a time whatever the format. The store tracks the byte offset of every record, so changing
+     * records only writes them and, if their size changed, the records after them.
+     */
+    class ChainStore {
+    public:
+        /**
+         * @brief Construct a new Chain Store object
+         *
+         * @param filePath
+         */
+        explicit ChainStore(const std::string& filePath);
+
+        virtual ~ChainStore() = default;
+
+        /**
+         * @brief Open the store of a chain file, in the format the file already has
+         *
+         * @param filePath
+         * @param format The format of the file if it is missing or empty
+         * @return
+         */
+        static std::unique_ptr<ChainStore> open(const std::string& filePath, ChainFormat format);
+
+        /**
+         * @brief Create the store of a format, whatever the file already holds
+         *
+         * @param filePath
+         * @param format
+         * @return
+         */
+        static std::unique_ptr<ChainStore> create(const std::string& filePath, ChainFormat format);
+
+        /**
+         * @brief Get the format a chain file is in, from its first bytes
+         *
+         * @param filePath
+         * @param fallback The format of a missing or empty file
+         * @return
+         */
+        static ChainFormat detect(const std::string& filePath, ChainFormat fallback);
+
+        /**
+         * @brief Convert a string to a ChainFormat
+         *
+         * @param format "text" or "binary"
+         * @return
+         */
+        static ChainFormat parseFormat(const std::string& format);
+
+        /**
+         * @brief Copy a chain file into another file in the given format, one record at a time
+         *
+         * @param sourcePath Read in the format it already has
+         * @param targetPath Overwritten
+         * @param format
+         * @return The number of records converted
+         */
+        static size_t convert(const std::string& sourcePath, const std::string& targetPath, ChainFormat format);
+
+        /**
+         * @brief Convert a chain file in place if it is not in the given format yet
+         * The file is converted next to itself and then renamed over, so a kill midway leaves the original intact.
+         *
+         * @param filePath
+         * @param format
+         * @return Whether the file was converted
+         */
+        static bool migrate(const std::string& filePath, ChainFormat format);
+
+        /**
+         * @brief Read every record of the file in order
+         *
+         * @param visit Called with each record
+         */
+        void scan(const std::function<void(const BlockData&)>& visit) const;
+
+        /**
+         * @brief Read every record of the file
+         *
+         * @return
+         */
+        [[nodiscard]] std::vector<BlockData> load() const;
+
+        /**
+         * @brief Append a record to the end of the file
+         *
+         * @param record
+         */
+        void append(const BlockData& record);
+
+        /**
+         * @brief Append records to the end of the file, opening it once
+         *
+         * @param records
+         */
+        void append(const std::vector<BlockData>& records);
+
+        /**
+         * @brief Replace consecutive records of the file
+         * Records that keep their size are patched in place. From the first one whose size changed on, the file is
+         * truncated and the rest of it is rewritten, which moves the records after the replaced ones too.
+         *
+         * @param first The index of the first record replaced
+         * @param records
+         */
+        void update(size_t first, const std::vector<BlockData>& records);
+
+        /**
+         * @brief Remove every record from the file
+         */
+        void clear();
+
+        // getters
+        [[nodiscard]] virtual ChainFormat getFormat() const = 0;
+        [[nodiscard]] const std::string& getFilePath() const;
+        [[nodiscard]] size_t getRecordCount();
+
+    protected:
+        /**
+         * @brief Get the mode the file is opened in besides reading or writing
+         *
+         * @return
+         */
+        [[nodiscard]] virtual std::ios::openmode getOpenMode() const = 0;
+
+        /**
+         * @brief Write what precedes the first record of a file
+         *
+         * @param out
+         */
+        virtual void writeHeader(std::ostream& out) const = 0;
+
+        /**
+         * @brief Read and check what precedes the first record of a non-empty file
+         *
+         * @param in
+         */
+        virtual void readHeader(std::istream& in) const = 0;
+
+        /**
+         * @brief Encode a record
+         *
+         * @param out
+         * @param record
+         */
+        virtual void writeRecord(std::ostream& out, const BlockData& record) const = 0;
+
+        /**
+         * @brief Decode the next record
+         *
+         * @param in
+         * @param record
+         * @return Whether a record was read, false at the end of the file
+         */
+        virtual bool readRecord(std::istream& in, BlockData& record) const = 0;
+
+        std::string filePath;
+
+    private:
+        /**
+         * @brief Read every record of the file in order, each may be moved from by the visitor
+         *
+         * @param visit Called with each record and the offset it starts at
+         * @return The offset the last whole record ends at
+         */
+        std::streamoff readRecords(const std::function<void(BlockData&, std::streamoff)>& visit) const;
+
+        /**
+         * @brief Find the offset of every record of the file, once
+         * Until then the store holds no offsets, so only the first change after opening reads the file.
+         */
+        void index();
+
+        [[nodiscard]] std::string encodeHeader() const;
+        [[nodiscard]] std::string encodeRecord(const BlockData& record) const;
+
+        bool indexed = false;
+        std::vector<std::streamoff> offsets; /** The offset every record starts at */
+        std::streamoff end = 0; /** The offset the last whole record ends at, anything after it is a cut short record */
+    };
+} // namespace filesystem
+
+#endif // CHAINSTORE_H
@@ -1,5 +1,5 @@
 #include "FileReader.h"
-#include "../blockchain/enums/BlockAttribute.h"
+#include "ChainStore.h"
 #include "../utils/Structures.h"
 #include <fstream>
 #include <sstream>
@@ -64,88 +64,52 @@ namespace filesystem {
     }
 
     std::vector<int> FileReader::extractBlockIds(const std::string& filePath, const std::string& blockType) {
-        std::ifstream file(filePath);
         std::vector<int> ids;
-        std::string line;
-        bool isTargetBlock = false;
 
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file: " << filePath << std::endl;
-            return ids;
-        }
-
-        while (std::getline(file, line)) {
-            // Identify the start of the target block
-            if (line.find("Block Type: " + blockType) != std::string::npos) {
-                isTargetBlock = true;
-            }
+        try {
+            // The chain file is read in whichever format it is kept in
+            ChainStore::open(filePath, ChainFormat::TEXT)->scan([&](const BlockData& block) {
+                if (blockchain::enums::BlockTypeUtils::toString(block.type) != blockType) {
+                    return;
+                }
 
-            // Once inside the target block, look for the "Information" line
-            if (isTargetBlock && line.find("Information: ") != std::string::npos) {
-                // Extract ID from the Information line
-                std::istringstream iss(line);
-                std::string part;
-                while (std::getline(iss, part, '|')) {
-                    std::size_t idPos = part.find("ID: ");
-                    if (idPos != std::string::npos) {
-                        try {
-                            std::string idStr = part.substr(idPos + 4); // 4 is the length of "ID: "
-                            int id = std::stoi(idStr);
-                            ids.push_back(id);
-                            break; // Assuming only one ID per Information line
-                        } catch (const std::exception& e) {
-                            std::cerr << "Error converting ID to integer: " << e.what() << std::endl;
-                        }
-                    }
+                // Extract the ID of every record from the information of the block
+                for (int id : extractRecordIds(block.information)) {
+                    ids.push_back(id);
                 }
-                isTargetBlock = false; // Reset for the next block
-            }
+            });
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
         }
 
         return ids;
     }
 
-    void FileReader::parseChainFile(const std::string& filePath) {
-        using namespace blockchain::enums;
-
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open file: " + filePath);
-        }
-
-        std::string line;
-        BlockData currentBlock;
-        bool blockStarted = false;
-
-        while (getline(file, line)) {
-            if (line.find(BlockAttributeUtils::toString(BlockAttribute::TYPE) + ":") != std::string::npos) {
-                if (blockStarted) {
-                    // Save the previous block before starting a new one
-                    blocks.push_back(currentBlock);
-                    currentBlock = BlockData(); // Reset for next block
+    std::vector<int> FileReader::extractRecordIds(const std::string& information) {
+        std::vector<int> ids;
+        std::istringstream iss(information);
+        std::string part;
+
+        // Every record of a block has one ID field
+        while (std::getline(iss, part, '|')) {
+            std::size_t idPos = part.find("ID: ");
+            if (idPos != std::string::npos) {
+                try {
+                    std::string idStr = part.substr(idPos + 4); // 4 is the length of "ID: "
+                    int id = std::stoi(idStr);
+                    ids.push_back(id);
+                } catch (const std::exception& e) {
+                    std::cerr << "Error converting ID to integer: " << e.what() << std::endl;
                 }
-                currentBlock.type = BlockTypeUtils::fromString(extractBlockData(line));
-                blockStarted = true;
-            } else if (line.find(BlockAttributeUtils::toString(BlockAttribute::HEIGHT)+ ":") != std::string::npos) {
-                currentBlock.height = std::stoi(extractBlockData(line));
-            } else if (line.find(BlockAttributeUtils::toString(BlockAttribute::NONCE) + ":") != std::string::npos) {
-                currentBlock.nonce = std::stoi(extractBlockData(line));
-            } else if (line.find(BlockAttributeUtils::toString(BlockAttribute::HASH) + ":") != std::string::npos) {
-                currentBlock.currentHash = extractBlockData(line);
-            } else if (line.find(BlockAttributeUtils::toString(BlockAttribute::PREV_HASH) + ":") != std::string::npos) {
-                currentBlock.previousHash = extractBlockData(line);
-            } else if (line.find(BlockAttributeUtils::toString(BlockAttribute::TIMESTAMP) + ":") != std::string::npos) {
-                currentBlock.timestamp = extractBlockData(line);
-            } else if (line.find(BlockAttributeUtils::toString(BlockAttribute::INFORMATION) + ":") != std::string::npos) {
-                currentBlock.information = extractBlockData(line);
-            } else if (line.find(BlockAttributeUtils::toString(BlockAttribute::VISIBLE) + ":") != std::string::npos) {
-                currentBlock.visible = extractBlockData(line) == "true";
             }
         }
 
-        if (blockStarted) { // Add the last block if there is one
-            blocks.push_back(currentBlock);
-        }
+        return ids;
+    }
+
+    void FileReader::parseChainFile(const std::string& filePath) {
+        // The chain file is read in whichever format it is kept in, a missing file throws
+        blocks = ChainStore::open(filePath, ChainFormat::TEXT)->load();
     }
 
     void FileReader::parseParticipantFile(const std::string& filePath) {
@@ -174,14 +138,6 @@ namespace filesystem {
         }
     }
 
-    std::string FileReader::extractBlockData(const std::string& line) {
-        auto pos = line.find(':');
-        if (pos != std::string::npos && pos + 1 < line.length()) {
-            return line.substr(pos + 2); // Skip the colon and space
-        }
-        return "";
-    }
-
     void FileReader::trim(std::string& s) {
         s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch) {
             return !std::isspace(ch);
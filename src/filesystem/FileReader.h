@@ -18,12 +18,17 @@ namespace filesystem {
     struct BlockData {
         blockchain::enums::BlockType type;
         int height;
-        int nonce;
+        int version = 0; /** 0 when the record carries no version */
+        uint32_t nonce;
         std::string currentHash;
         std::string previousHash;
+        std::string merkleRoot;
         std::string timestamp;
+        std::string bits;
         std::string information;
-        bool visible;
+        bool visible = true;
+        bool mined = true;
+        uint64_t miningTime = 0;
     };
 
     class FileReader {
@@ -40,6 +45,7 @@ namespace filesystem {
 
         [[nodiscard]] const std::vector<BlockData>& getBlocks() const;
         static std::vector<int> extractBlockIds(const std::string& filePath, const std::string& blockType);
+        static std::vector<int> extractRecordIds(const std::string& information);
 
     private:
         std::vector<BlockData> blocks;
@@ -49,7 +55,6 @@ namespace filesystem {
         std::map<std::string, std::vector<std::string>> idToDataMap;
         static void trim(std::string& s);
         static std::vector<std::string> splitLine(const std::string& line);
-        [[nodiscard]] static std::string extractBlockData(const std::string& line) ;
     };
 } // namespace filesystem
 
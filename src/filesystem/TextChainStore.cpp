@@ -0,0 +1,122 @@
+#include "TextChainStore.h"
+#include "../blockchain/enums/BlockAttribute.h"
+
+namespace filesystem {
+    namespace {
+        using blockchain::enums::BlockAttribute;
+        using blockchain::enums::BlockAttributeUtils;
+
+        const std::string TYPE = BlockAttributeUtils::toString(BlockAttribute::TYPE);
+        const std::string HEIGHT = BlockAttributeUtils::toString(BlockAttribute::HEIGHT);
+        const std::string VERSION = BlockAttributeUtils::toString(BlockAttribute::VERSION);
+        const std::string NONCE = BlockAttributeUtils::toString(BlockAttribute::NONCE);
+        const std::string HASH = BlockAttributeUtils::toString(BlockAttribute::HASH);
+        const std::string PREV_HASH = BlockAttributeUtils::toString(BlockAttribute::PREV_HASH);
+        const std::string MERKLE_ROOT = BlockAttributeUtils::toString(BlockAttribute::MERKLE_ROOT);
+        const std::string TIMESTAMP = BlockAttributeUtils::toString(BlockAttribute::TIMESTAMP);
+        const std::string BITS = BlockAttributeUtils::toString(BlockAttribute::BITS);
+        const std::string INFORMATION = BlockAttributeUtils::toString(BlockAttribute::INFORMATION);
+        const std::string MINED = BlockAttributeUtils::toString(BlockAttribute::MINED);
+        const std::string VISIBLE = BlockAttributeUtils::toString(BlockAttribute::VISIBLE);
+        const std::string MINING_TIME = BlockAttributeUtils::toString(BlockAttribute::MINING_TIME);
+    }
+
+    ChainFormat TextChainStore::getFormat() const {
+        return ChainFormat::TEXT;
+    }
+
+    std::ios::openmode TextChainStore::getOpenMode() const {
+        return std::ios::openmode();
+    }
+
+    void TextChainStore::writeHeader(std::ostream&) const {
+        // Text records need no header
+    }
+
+    void TextChainStore::readHeader(std::istream&) const {
+        // Text records need no header
+    }
+
+    void TextChainStore::writeRecord(std::ostream& out, const BlockData& record) const {
+        out << TYPE << ": " << blockchain::enums::BlockTypeUtils::toString(record.type) << '\n'
+            << HEIGHT << ": " << record.height << '\n'
+            << VERSION << ": " << record.version << '\n'
+            << NONCE << ": " << record.nonce << '\n'
+            << HASH << ": " << record.currentHash << '\n'
+            << PREV_HASH << ": " << record.previousHash << '\n'
+            << MERKLE_ROOT << ": " << record.merkleRoot << '\n'
+            << TIMESTAMP << ": " << record.timestamp << '\n'
+            << BITS << ": " << record.bits << '\n'
+            << INFORMATION << ": " << record.information << '\n'
+            << MINED << ": " << (record.mined ? "true" : "false") << '\n'
+            << VISIBLE << ": " << (record.visible ? "true" : "false") << '\n'
+            << MINING_TIME << ": " << record.miningTime << '\n'
+            << '\n'; // Add an empty line for readability
+    }
+
+    bool TextChainStore::readRecord(std::istream& in, BlockData& record) const {
+        // The position is counted rather than asked for every line, it is only needed to give back the next block type line
+        std::streampos position = in.tellg();
+        std::string line;
+        bool started = false;
+
+        while (std::getline(in, line)) {
+            const std::streampos lineStart = position;
+            position += static_cast<std::streamoff>(line.size() + 1);
+
+            if (line.empty()) {
+                if (started) {
+                    return true; // A blank line ends the block
+                }
+                continue;
+            }
+
+            // Every line is "Key: value", the key is matched whole instead of searched for
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            const std::string key = line.substr(0, colon);
+            const std::string value = colon + 2 <= line.size() ? line.substr(colon + 2) : "";
+
+            if (key == TYPE) {
+                if (started) {
+                    // A block without a closing blank line, the type line belongs to the next one
+                    in.seekg(lineStart);
+                    return true;
+                }
+                record = BlockData();
+                record.type = blockchain::enums::BlockTypeUtils::fromString(value);
+                started = true;
+            } else if (!started) {
+                continue;
+            } else if (key == HEIGHT) {
+                record.height = std::stoi(value);
+            } else if (key == VERSION) {
+                record.version = std::stoi(value);
+            } else if (key == NONCE) {
+                record.nonce = static_cast<uint32_t>(std::stoul(value));
+            } else if (key == HASH) {
+                record.currentHash = value;
+            } else if (key == PREV_HASH) {
+                record.previousHash = value;
+            } else if (key == MERKLE_ROOT) {
+                record.merkleRoot = value;
+            } else if (key == TIMESTAMP) {
+                record.timestamp = value;
+            } else if (key == BITS) {
+                record.bits = value;
+            } else if (key == INFORMATION) {
+                record.information = value;
+            } else if (key == MINED) {
+                record.mined = value == "true";
+            } else if (key == VISIBLE) {
+                record.visible = value == "true";
+            } else if (key == MINING_TIME) {
+                record.miningTime = std::stoull(value);
+            }
+        }
+
+        return started;
+    }
+} // namespace filesystem
@@ -0,0 +1,26 @@
+#ifndef TEXTCHAINSTORE_H
+#define TEXTCHAINSTORE_H
+
+#include "ChainStore.h"
+
+namespace filesystem {
+    /**
+     * @brief Keeps a chain as "Key: value" lines, one paragraph per block
+     * The format the chain has always been logged in, readable and editable by hand.
+     */
+    class TextChainStore : public ChainStore {
+    public:
+        using ChainStore::ChainStore;
+
+        [[nodiscard]] ChainFormat getFormat() const override;
+
+    protected:
+        [[nodiscard]] std::ios::openmode getOpenMode() const override;
+        void writeHeader(std::ostream& out) const override;
+        void readHeader(std::istream& in) const override;
+        void writeRecord(std::ostream& out, const BlockData& record) const override;
+        bool readRecord(std::istream& in, BlockData& record) const override;
+    };
+} // namespace filesystem
+
+#endif // TEXTCHAINSTORE_H
@@ -1,10 +1,27 @@
 #include "Application.h"
+#include <iostream>
+#include <string>
 
 /**
  * @brief Initializes the application.
+ * Started with --pool, the process coordinates a local mining pool; started with --pool-worker, it only mines for one.
+ * Started with --convert-chain <source> <target> <text|binary>, it only converts a blockchain file to a record format.
  * @return
  */
-int main() {
+int main(int argc, char* argv[]) {
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "--pool-worker") {
+        return Application::runMiningPoolWorker();
+    }
+    if (mode == "--convert-chain") {
+        if (argc != 5) {
+            std::cerr << "Usage: " << argv[0] << " --convert-chain <source> <target> <text|binary>" << std::endl;
+            return 1;
+        }
+        return Application::convertChainFile(argv[2], argv[3], argv[4]);
+    }
+
+    Application::setCoordinatesMiningPool(mode == "--pool");
     Application app;
     app.init();
     app.run();